@@ -1,64 +1,133 @@
-/**
- * \file
- *         A gateway to connect a piccino WSN to a USB port
- *
- * \author
- *         Attilio Dona' - <piccino.lab@gmail.com>
- */
-
-#include "contiki.h"
-#include "dev/button-sensor.h"
-#include "dev/leds.h"
-#include "net/rime.h"
-#include "debug.h"
-#define DEBUG 1
-#if DEBUG
-//#include <stdio.h>
-//#define PRINTF(...) printf(__VA_ARGS__)
-#define PUTSTRING(...) putstring(__VA_ARGS__)
-#else
-#define PRINTF(...)
-#define PUTSTRING(...)
-#endif
-
-static void
-abc_recv(struct abc_conn *c)
-{
-  //PRINTF("abc message received '%s'\n", (char *)packetbuf_dataptr());
-  PUTSTRING((char *)packetbuf_dataptr());
-  PUTSTRING("\n");
-}
-static const struct abc_callbacks abc_call = {abc_recv};
-static struct abc_conn abc;
-
-/*---------------------------------------------------------------------------*/
-PROCESS(hello_world_process, "Hello world process");
-AUTOSTART_PROCESSES(&hello_world_process);
-/*---------------------------------------------------------------------------*/
-PROCESS_THREAD(hello_world_process, ev, data)
-{
-  struct sensors_sensor *sensor;
-
-  PROCESS_EXITHANDLER(abc_close(&abc);)
-
-  PROCESS_BEGIN();
-
-  abc_open(&abc, 128, &abc_call);
-
-  while(1) {
-    PROCESS_WAIT_EVENT_UNTIL(ev == sensors_event);
-
-    sensor = (struct sensors_sensor *)data;
-    if(sensor == &button1) {
-      leds_toggle(LEDS_GREEN);
-      packetbuf_copyfrom("Hello", 6);
-      abc_send(&abc);
-    }
-    else if(sensor == &button2) {
-      leds_toggle(LEDS_RED);
-    }
-  }
-
-  PROCESS_END();
-}
-/*---------------------------------------------------------------------------*/
+/**
+ * \file
+ *         A gateway to connect a piccino WSN to a USB port.
+ *
+ *         Every packet goes to the host as a gw-frame.h binary frame, with
+ *         sender, RSSI/LQI and reception time. The frames received within
+ *         BATCH_WINDOW go out in one burst.
+ *
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+
+#include "contiki.h"
+#include "dev/button-sensor.h"
+#include "dev/leds.h"
+#include "net/rime.h"
+#include "dev/cc1101-rf.h"
+#include "dev/io-arch.h"
+#include "debug.h"
+#include "gw-frame.h"
+#define DEBUG 1
+#if DEBUG
+//#include <stdio.h>
+//#define PRINTF(...) printf(__VA_ARGS__)
+#define PUTSTRING(...) putstring(__VA_ARGS__)
+#else
+#define PRINTF(...)
+#define PUTSTRING(...)
+#endif
+
+/* Frames received this close to the first one go out in the same burst */
+#define BATCH_WINDOW (CLOCK_SECOND / 16)
+#define BATCH_SIZE   160
+
+static uint8_t batch[BATCH_SIZE];
+static uint8_t batch_len;
+static struct ctimer batch_timer;
+
+static void
+batch_flush(void *ptr)
+{
+  uint8_t i;
+
+  ctimer_stop(&batch_timer);
+  for(i = 0; i < batch_len; i++) {
+    io_arch_writeb(batch[i]);
+  }
+  batch_len = 0;
+}
+
+static void
+abc_recv(struct abc_conn *c)
+{
+  uint8_t len;
+
+  len = packetbuf_datalen() > GW_FRAME_MAX_PAYLOAD ?
+    GW_FRAME_MAX_PAYLOAD : packetbuf_datalen();
+
+  if(batch_len + len + GW_FRAME_OVERHEAD > BATCH_SIZE) {
+    batch_flush(NULL);
+  }
+  if(batch_len == 0) {
+    ctimer_set(&batch_timer, BATCH_WINDOW, batch_flush, NULL);
+  }
+
+  batch_len += gw_frame_encode(&batch[batch_len],
+                               packetbuf_addr(PACKETBUF_ADDR_SENDER)->u8,
+                               (int8_t)packetbuf_attr(PACKETBUF_ATTR_RSSI),
+                               packetbuf_attr(PACKETBUF_ATTR_LINK_QUALITY),
+                               clock_time(), packetbuf_dataptr(), len);
+}
+static const struct abc_callbacks abc_call = {abc_recv};
+static struct abc_conn abc;
+
+#if CC1101_RF_CONF_RX_LATENCY
+/*
+ * End of frame to NETSTACK_RDC.input(), in rtimer ticks (64 us). Sent as a
+ * frame from the gateway's own address, payload last[2] max[2] little
+ * endian, so the host stream stays binary
+ */
+static void
+report_latency(void)
+{
+  rtimer_clock_t last, max;
+  uint8_t payload[4];
+
+  cc1101_rf_rx_latency(&last, &max);
+  payload[0] = last;
+  payload[1] = last >> 8;
+  payload[2] = max;
+  payload[3] = max >> 8;
+
+  batch_flush(NULL);
+  batch_len = gw_frame_encode(batch, rimeaddr_node_addr.u8, 0, 0,
+                              clock_time(), payload, sizeof(payload));
+  batch_flush(NULL);
+}
+#endif
+
+/*---------------------------------------------------------------------------*/
+PROCESS(hello_world_process, "Hello world process");
+AUTOSTART_PROCESSES(&hello_world_process);
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(hello_world_process, ev, data)
+{
+  struct sensors_sensor *sensor;
+
+  PROCESS_EXITHANDLER(abc_close(&abc);)
+
+  PROCESS_BEGIN();
+
+  abc_open(&abc, 128, &abc_call);
+
+  while(1) {
+    PROCESS_WAIT_EVENT_UNTIL(ev == sensors_event);
+
+    sensor = (struct sensors_sensor *)data;
+    if(sensor == &button1) {
+      leds_toggle(LEDS_GREEN);
+      packetbuf_copyfrom("Hello", 6);
+      abc_send(&abc);
+    }
+    else if(sensor == &button2) {
+      leds_toggle(LEDS_RED);
+#if CC1101_RF_CONF_RX_LATENCY
+      report_latency();
+#endif
+    }
+  }
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
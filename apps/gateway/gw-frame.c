@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Gateway serial framing, see gw-frame.h
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#include "gw-frame.h"
+#include "lib/crc16.h"
+
+#include <string.h>
+
+/*---------------------------------------------------------------------------*/
+uint8_t
+gw_frame_encode(uint8_t *buf, const uint8_t *src, int8_t rssi, uint8_t lqi,
+                uint16_t tick, const uint8_t *payload, uint8_t len)
+{
+  uint16_t crc;
+  uint8_t n;
+
+  if(len > GW_FRAME_MAX_PAYLOAD) {
+    len = GW_FRAME_MAX_PAYLOAD;
+  }
+
+  buf[0] = GW_FRAME_SYNC;
+  buf[1] = GW_FRAME_HDR_LEN + len;
+  buf[2] = src[0];
+  buf[3] = src[1];
+  buf[4] = rssi;
+  buf[5] = lqi;
+  buf[6] = tick & 0xFF;
+  buf[7] = tick >> 8;
+  memcpy(&buf[8], payload, len);
+
+  n = 2 + GW_FRAME_HDR_LEN + len;
+  crc = crc16_data(&buf[1], n - 1, 0);
+  buf[n++] = crc & 0xFF;
+  buf[n++] = crc >> 8;
+
+  return n;
+}
+/*---------------------------------------------------------------------------*/
+void
+gw_parser_init(struct gw_parser *p)
+{
+  p->pos = 0;
+  p->errors = 0;
+}
+/*---------------------------------------------------------------------------*/
+/* Forget the first n bytes of the buffer */
+static void
+drop(struct gw_parser *p, uint8_t n)
+{
+  p->pos -= n;
+  memmove(p->buf, &p->buf[n], p->pos);
+}
+/*---------------------------------------------------------------------------*/
+int
+gw_parser_next(struct gw_parser *p, struct gw_frame *f)
+{
+  uint16_t crc;
+  uint8_t len;
+  uint8_t *b;
+
+  /*
+   * buf holds the bytes from a candidate sync on. When it turns out not to
+   * be a frame only the sync is dropped: a real frame may start in the
+   * bytes taken as its length or body.
+   */
+  while(p->pos > 0) {
+    if(p->buf[0] != GW_FRAME_SYNC) {
+      drop(p, 1);
+      continue;
+    }
+    if(p->pos < 2) {
+      return 0;
+    }
+    len = p->buf[1];
+    if(len < GW_FRAME_HDR_LEN || len > GW_FRAME_HDR_LEN + GW_FRAME_MAX_PAYLOAD) {
+      drop(p, 1);
+      continue;
+    }
+    if(p->pos < 2 + len + 2) {
+      return 0;
+    }
+
+    b = &p->buf[2];
+    crc = crc16_data(&p->buf[1], 1 + len, 0);
+    if(b[len] != (crc & 0xFF) || b[len + 1] != (crc >> 8)) {
+      p->errors++;
+      drop(p, 1);
+      continue;
+    }
+
+    f->src[0] = b[0];
+    f->src[1] = b[1];
+    f->rssi = (int8_t)b[2];
+    f->lqi = b[3];
+    f->tick = b[4] | ((uint16_t)b[5] << 8);
+    f->len = len - GW_FRAME_HDR_LEN;
+    memcpy(f->payload, &b[GW_FRAME_HDR_LEN], f->len);
+    drop(p, 2 + len + 2);
+    return 1;
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+int
+gw_parser_input(struct gw_parser *p, uint8_t c, struct gw_frame *f)
+{
+  /* Nothing to keep before a sync */
+  if(p->pos == 0 && c != GW_FRAME_SYNC) {
+    return 0;
+  }
+  p->buf[p->pos++] = c;
+  return gw_parser_next(p, f);
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Binary framing of the packets the gateway sends to the host.
+ *
+ *         A frame on the serial line is
+ *
+ *           0xA5 | len | src[2] | rssi | lqi | tick[2] | payload | crc[2]
+ *
+ *         len counts the bytes from src to the end of the payload, tick is
+ *         the gateway clock_time() at reception, tick and crc are little
+ *         endian. The crc is the Contiki lib/crc16 of len and of the bytes
+ *         that follow it, payload included.
+ *
+ *         The gateway sends the frames received within a short window in
+ *         one burst. The parser skips anything between the frames, so the
+ *         debug output of the firmware does not break the stream: a 0xA5
+ *         in there that does not start a good frame costs that byte only,
+ *         the search for the sync goes on right after it.
+ *
+ *         Plain C: tools/gateway builds it for the host.
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#ifndef GW_FRAME_H_
+#define GW_FRAME_H_
+
+#include <stdint.h>
+
+#define GW_FRAME_SYNC        0xA5
+
+#define GW_FRAME_HDR_LEN     6   /* src, rssi, lqi, tick */
+#define GW_FRAME_MAX_PAYLOAD 127
+
+/* Bytes on the line besides the payload */
+#define GW_FRAME_OVERHEAD    (2 + GW_FRAME_HDR_LEN + 2)
+
+struct gw_frame {
+  uint8_t src[2];
+  int8_t rssi;
+  uint8_t lqi;
+  uint16_t tick;
+  uint8_t len;
+  uint8_t payload[GW_FRAME_MAX_PAYLOAD];
+};
+
+struct gw_parser {
+  uint8_t pos;     /* bytes in buf, from a candidate sync on */
+  uint16_t errors; /* candidate frames dropped for a bad crc */
+  uint8_t buf[GW_FRAME_OVERHEAD + GW_FRAME_MAX_PAYLOAD];
+};
+
+/*
+ * Write the frame for 'payload' into buf, that has room for
+ * len + GW_FRAME_OVERHEAD bytes. Returns the bytes written.
+ */
+uint8_t gw_frame_encode(uint8_t *buf, const uint8_t *src, int8_t rssi,
+                        uint8_t lqi, uint16_t tick,
+                        const uint8_t *payload, uint8_t len);
+
+void gw_parser_init(struct gw_parser *p);
+
+/* Feed one byte, 1 when f holds a new frame with a good crc */
+int gw_parser_input(struct gw_parser *p, uint8_t c, struct gw_frame *f);
+
+/*
+ * A bad crc sends the parser back over the bytes it had taken for that
+ * frame, and they may hold more than one frame: call this after
+ * gw_parser_input() returned 1 until it returns 0.
+ */
+int gw_parser_next(struct gw_parser *p, struct gw_frame *f);
+
+#endif /* GW_FRAME_H_ */
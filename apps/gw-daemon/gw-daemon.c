@@ -0,0 +1,546 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Host side of the gateway: reads the gateway serial line, checks
+ *         the gw-frame.h frames and hands them to the local clients.
+ *
+ *         - UNIX stream socket (-s): every client gets the frame stream as
+ *           the gateway sent it.
+ *         - UDP on 127.0.0.1 (-u): a datagram subscribes the sender, which
+ *           then gets the frames batched in datagrams ("stop" unsubscribes).
+ *
+ *         The tty is read in large non blocking chunks from the native
+ *         select() loop and every chunk goes to each client with a single
+ *         write, so the daemon keeps up with thousands of frames a second.
+ *         A client that is too slow loses whole batches, never part of a
+ *         frame.
+ *         The per node counters are printed every STATS_INTERVAL and when
+ *         "stats" is typed on stdin.
+ *
+ *         usage: gw-daemon.native [-b baud] [-s path] [-u port] tty
+ *
+ *         tools/gateway/gw-emu is a gateway on a pty to test it.
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+
+#include "contiki.h"
+#include "dev/serial-line.h"
+#include "gw-frame.h"
+#include "gw-tty.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#define DEFAULT_SOCKET  "/tmp/gw-daemon.sock"
+#define DEFAULT_PORT    7530
+
+#define READ_SIZE       65536
+#define READS_MAX       8      /* chunks per select() round */
+#define OUT_SIZE        16384  /* frames sent with one write */
+#define CLIENTS_MAX     16
+#define NODES_MAX       256
+
+#define STATS_INTERVAL  (10 * CLOCK_SECOND)
+
+struct node {
+  uint8_t src[2];
+  unsigned long frames;
+  unsigned long bytes;
+  long rssi_sum;
+  int8_t rssi_min;
+  int8_t rssi_max;
+  unsigned long lqi_sum;
+};
+
+/*
+ * A stream client whose socket took part of a frame keeps the rest in
+ * tail: it goes out before anything else, so the client never sees a
+ * frame cut short.
+ */
+struct client {
+  int fd;
+  unsigned long dropped;
+  size_t tail_len;
+  unsigned char tail[GW_FRAME_OVERHEAD + GW_FRAME_MAX_PAYLOAD];
+};
+
+struct peer {
+  struct sockaddr_in addr;
+  unsigned long dropped;
+};
+
+extern int contiki_argc;
+extern char **contiki_argv;
+
+static int tty_fd = -1;
+static int unix_fd = -1;
+static int udp_fd = -1;
+
+static struct client clients[CLIENTS_MAX];
+static int nclients;
+static struct peer peers[CLIENTS_MAX];
+static int npeers;
+
+static struct node nodes[NODES_MAX];
+static int nnodes;
+static unsigned long frames;
+static unsigned long frames_last;
+static clock_time_t stats_time;
+
+static struct gw_parser parser;
+static struct gw_frame frame;
+static unsigned char in[READ_SIZE];
+static unsigned char out[OUT_SIZE];
+static size_t out_len;
+
+PROCESS(gw_daemon_process, "Gateway daemon");
+AUTOSTART_PROCESSES(&gw_daemon_process);
+/*---------------------------------------------------------------------------*/
+static struct node *
+node_get(const uint8_t *src)
+{
+  int i;
+
+  for(i = 0; i < nnodes; i++) {
+    if(nodes[i].src[0] == src[0] && nodes[i].src[1] == src[1]) {
+      return &nodes[i];
+    }
+  }
+  if(nnodes == NODES_MAX) {
+    return NULL;
+  }
+
+  memset(&nodes[nnodes], 0, sizeof(struct node));
+  nodes[nnodes].src[0] = src[0];
+  nodes[nnodes].src[1] = src[1];
+  nodes[nnodes].rssi_min = 127;
+  nodes[nnodes].rssi_max = -128;
+  return &nodes[nnodes++];
+}
+/*---------------------------------------------------------------------------*/
+static void
+stats_print(void)
+{
+  clock_time_t now = clock_time();
+  unsigned long rate;
+  int i;
+
+  rate = now != stats_time ?
+    (frames - frames_last) * CLOCK_SECOND / (now - stats_time) : 0;
+  printf("frames %lu (%lu/s) crc errors %lu, %d unix %d udp clients\n",
+         frames, rate, (unsigned long)parser.errors, nclients, npeers);
+  frames_last = frames;
+  stats_time = now;
+
+  for(i = 0; i < nnodes; i++) {
+    printf("  %u.%u frames %lu bytes %lu rssi %d/%ld/%d lqi %lu\n",
+           nodes[i].src[0], nodes[i].src[1], nodes[i].frames, nodes[i].bytes,
+           nodes[i].rssi_min, nodes[i].rssi_sum / (long)nodes[i].frames,
+           nodes[i].rssi_max, nodes[i].lqi_sum / nodes[i].frames);
+  }
+  for(i = 0; i < nclients; i++) {
+    if(clients[i].dropped) {
+      printf("  unix client %d: %lu writes dropped\n", i, clients[i].dropped);
+    }
+  }
+  for(i = 0; i < npeers; i++) {
+    if(peers[i].dropped) {
+      printf("  udp %s:%u: %lu datagrams dropped\n",
+             inet_ntoa(peers[i].addr.sin_addr), ntohs(peers[i].addr.sin_port),
+             peers[i].dropped);
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+client_close(int i)
+{
+  close(clients[i].fd);
+  nclients--;
+  clients[i] = clients[nclients];
+}
+/*---------------------------------------------------------------------------*/
+/*
+ * Send what is left of a frame cut short. 1 when it is all gone, 0 if the
+ * socket is still full, -1 if the client is gone.
+ */
+static int
+client_tail(struct client *c)
+{
+  ssize_t n;
+
+  if(c->tail_len == 0) {
+    return 1;
+  }
+
+  n = send(c->fd, c->tail, c->tail_len, MSG_DONTWAIT | MSG_NOSIGNAL);
+  if(n < 0) {
+    return errno == EAGAIN || errno == EWOULDBLOCK ? 0 : -1;
+  }
+  c->tail_len -= n;
+  memmove(c->tail, c->tail + n, c->tail_len);
+  return c->tail_len == 0;
+}
+/*---------------------------------------------------------------------------*/
+/* The socket took the first n bytes of out: keep the rest of that frame */
+static void
+client_cut(struct client *c, size_t n)
+{
+  size_t end;
+
+  /* out holds whole frames, their second byte is the length */
+  for(end = 0; end < n; end += out[end + 1] + 4);
+
+  c->tail_len = end - n;
+  memcpy(c->tail, out + n, c->tail_len);
+  if(end < out_len) {
+    /* the frames after it are lost */
+    c->dropped++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* One write of the decoded batch to every client */
+static void
+fanout_flush(void)
+{
+  ssize_t n;
+  int i;
+
+  if(out_len == 0) {
+    return;
+  }
+
+  for(i = 0; i < nclients; i++) {
+    switch(client_tail(&clients[i])) {
+    case -1:
+      client_close(i--);
+      continue;
+    case 0:
+      clients[i].dropped++;
+      continue;
+    }
+
+    n = send(clients[i].fd, out, out_len, MSG_DONTWAIT | MSG_NOSIGNAL);
+    if(n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      /* a slow client loses the batch, not the others */
+      clients[i].dropped++;
+    } else if(n < 0) {
+      client_close(i--);
+    } else if((size_t)n < out_len) {
+      client_cut(&clients[i], n);
+    }
+  }
+
+  for(i = 0; i < npeers; i++) {
+    if(sendto(udp_fd, out, out_len, MSG_DONTWAIT,
+              (struct sockaddr *)&peers[i].addr, sizeof(peers[i].addr)) < 0) {
+      peers[i].dropped++;
+    }
+  }
+
+  out_len = 0;
+}
+/*---------------------------------------------------------------------------*/
+static void
+frame_input(const struct gw_frame *f)
+{
+  struct node *n;
+
+  frames++;
+  n = node_get(f->src);
+  if(n != NULL) {
+    n->frames++;
+    n->bytes += f->len;
+    n->rssi_sum += f->rssi;
+    n->lqi_sum += f->lqi;
+    if(f->rssi < n->rssi_min) {
+      n->rssi_min = f->rssi;
+    }
+    if(f->rssi > n->rssi_max) {
+      n->rssi_max = f->rssi;
+    }
+  }
+
+  if(nclients == 0 && npeers == 0) {
+    return;
+  }
+  if(out_len + f->len + GW_FRAME_OVERHEAD > sizeof(out)) {
+    fanout_flush();
+  }
+  out_len += gw_frame_encode(out + out_len, f->src, f->rssi, f->lqi, f->tick,
+                             f->payload, f->len);
+}
+/*---------------------------------------------------------------------------*/
+static int
+tty_set_fd(fd_set *rset, fd_set *wset)
+{
+  FD_SET(tty_fd, rset);
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+tty_handle_fd(fd_set *rset, fd_set *wset)
+{
+  ssize_t n, i;
+  int reads;
+
+  if(!FD_ISSET(tty_fd, rset)) {
+    return;
+  }
+
+  for(reads = 0; reads < READS_MAX; reads++) {
+    n = read(tty_fd, in, sizeof(in));
+    if(n == 0 || (n < 0 && errno != EAGAIN && errno != EINTR)) {
+      printf("gw-daemon: gateway gone\n");
+      select_set_callback(tty_fd, NULL);
+      close(tty_fd);
+      break;
+    }
+    if(n < 0) {
+      break;
+    }
+    for(i = 0; i < n; i++) {
+      if(gw_parser_input(&parser, in[i], &frame)) {
+        do {
+          frame_input(&frame);
+        } while(gw_parser_next(&parser, &frame));
+      }
+    }
+    if((size_t)n < sizeof(in)) {
+      break;
+    }
+  }
+
+  fanout_flush();
+}
+/*---------------------------------------------------------------------------*/
+static const struct select_callback tty_callback = {
+  tty_set_fd, tty_handle_fd
+};
+/*---------------------------------------------------------------------------*/
+static int
+unix_set_fd(fd_set *rset, fd_set *wset)
+{
+  FD_SET(unix_fd, rset);
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+unix_handle_fd(fd_set *rset, fd_set *wset)
+{
+  int fd;
+
+  if(!FD_ISSET(unix_fd, rset)) {
+    return;
+  }
+
+  fd = accept(unix_fd, NULL, NULL);
+  if(fd < 0) {
+    return;
+  }
+  if(nclients == CLIENTS_MAX) {
+    close(fd);
+    return;
+  }
+  fcntl(fd, F_SETFL, O_NONBLOCK);
+  clients[nclients].fd = fd;
+  clients[nclients].dropped = 0;
+  clients[nclients].tail_len = 0;
+  nclients++;
+}
+/*---------------------------------------------------------------------------*/
+static const struct select_callback unix_callback = {
+  unix_set_fd, unix_handle_fd
+};
+/*---------------------------------------------------------------------------*/
+static int
+udp_set_fd(fd_set *rset, fd_set *wset)
+{
+  FD_SET(udp_fd, rset);
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+udp_handle_fd(fd_set *rset, fd_set *wset)
+{
+  struct sockaddr_in from;
+  socklen_t fromlen = sizeof(from);
+  char msg[16];
+  ssize_t n;
+  int i;
+
+  if(!FD_ISSET(udp_fd, rset)) {
+    return;
+  }
+
+  n = recvfrom(udp_fd, msg, sizeof(msg) - 1, MSG_DONTWAIT,
+               (struct sockaddr *)&from, &fromlen);
+  if(n < 0) {
+    return;
+  }
+  msg[n] = '\0';
+
+  for(i = 0; i < npeers; i++) {
+    if(peers[i].addr.sin_addr.s_addr == from.sin_addr.s_addr &&
+       peers[i].addr.sin_port == from.sin_port) {
+      break;
+    }
+  }
+
+  if(strncmp(msg, "stop", 4) == 0) {
+    if(i < npeers) {
+      peers[i] = peers[--npeers];
+    }
+  } else if(i == npeers && npeers < CLIENTS_MAX) {
+    peers[npeers].addr = from;
+    peers[npeers].dropped = 0;
+    npeers++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static const struct select_callback udp_callback = {
+  udp_set_fd, udp_handle_fd
+};
+/*---------------------------------------------------------------------------*/
+static int
+unix_open(const char *path)
+{
+  struct sockaddr_un addr;
+  int fd;
+
+  fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if(fd < 0) {
+    return -1;
+  }
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+  unlink(path);
+  if(bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+     listen(fd, CLIENTS_MAX) < 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+/*---------------------------------------------------------------------------*/
+static int
+udp_open(int port)
+{
+  struct sockaddr_in addr;
+  int fd;
+
+  fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if(fd < 0) {
+    return -1;
+  }
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(port);
+  if(bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+/*---------------------------------------------------------------------------*/
+static int
+setup(void)
+{
+  const char *socket_path = DEFAULT_SOCKET;
+  int port = DEFAULT_PORT;
+  int baud = GW_TTY_BAUD;
+  int opt;
+
+  while((opt = getopt(contiki_argc, contiki_argv, "b:s:u:")) != -1) {
+    switch(opt) {
+    case 'b':
+      baud = atoi(optarg);
+      break;
+    case 's':
+      socket_path = optarg;
+      break;
+    case 'u':
+      port = atoi(optarg);
+      break;
+    default:
+      return 0;
+    }
+  }
+  if(optind >= contiki_argc) {
+    return 0;
+  }
+
+  tty_fd = gw_tty_open(contiki_argv[optind], 0, baud);
+  if(tty_fd < 0) {
+    perror(contiki_argv[optind]);
+    return 0;
+  }
+  fcntl(tty_fd, F_SETFL, O_NONBLOCK);
+
+  unix_fd = unix_open(socket_path);
+  udp_fd = udp_open(port);
+  if(unix_fd < 0 || udp_fd < 0) {
+    perror("gw-daemon: sockets");
+    return 0;
+  }
+
+  if(!select_set_callback(tty_fd, &tty_callback) ||
+     !select_set_callback(unix_fd, &unix_callback) ||
+     !select_set_callback(udp_fd, &udp_callback)) {
+    printf("gw-daemon: fd beyond SELECT_CONF_MAX\n");
+    return 0;
+  }
+
+  printf("gw-daemon: %s, unix %s, udp 127.0.0.1:%d\n",
+         contiki_argv[optind], socket_path, port);
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(gw_daemon_process, ev, data)
+{
+  static struct etimer et;
+
+  PROCESS_BEGIN();
+
+  if(!setup()) {
+    printf("usage: %s [-b baud] [-s path] [-u port] tty\n", contiki_argv[0]);
+    exit(1);
+  }
+
+  gw_parser_init(&parser);
+  stats_time = clock_time();
+  etimer_set(&et, STATS_INTERVAL);
+
+  while(1) {
+    PROCESS_WAIT_EVENT();
+
+    if(ev == PROCESS_EVENT_TIMER && etimer_expired(&et)) {
+      stats_print();
+      etimer_reset(&et);
+    } else if(ev == serial_line_event_message &&
+              strcmp((char *)data, "stats") == 0) {
+      stats_print();
+    }
+  }
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
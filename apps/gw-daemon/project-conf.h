@@ -0,0 +1,10 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+#ifndef PROJECT_CONF_H_
+#define PROJECT_CONF_H_
+
+#endif /* PROJECT_CONF_H_ */
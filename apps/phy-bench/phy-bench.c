@@ -0,0 +1,182 @@
+/**
+ * \file
+ *         PHY profiles benchmark: press button 1 on one board, the other one
+ *         receives. For every CC1101_RF_PHY_* profile the sender announces
+ *         the profile at the boot data rate, then both switch to it and
+ *         data frames go out back to back for BENCH_TIME.
+ *
+ *         The sender prints the throughput it got on air (bytes/s), timed
+ *         with the rtimer, the receiver how many frames it received out of
+ *         the ones sent.
+ *
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+
+#include "contiki.h"
+#include "dev/button-sensor.h"
+#include "dev/leds.h"
+#include "net/rime.h"
+#include "dev/cc1101-rf.h"
+#include "sys/rtimer.h"
+#include "debug.h"
+
+#include <string.h>
+
+#define BENCH_LEN      64                /* payload bytes of a data frame */
+/* rtimer ticks of data frames: thousands of frames at 500k, 6 at 1.2k */
+#define BENCH_TIME     (3UL * RTIMER_ARCH_SECOND)
+/* BENCH_TIME and the last frame, 0.6 s at 1.2k */
+#define BENCH_WINDOW   (5 * CLOCK_SECOND)
+
+#define BENCH_START    'S'
+#define BENCH_DATA     'D'
+
+struct bench_msg {
+  uint8_t type;
+  uint8_t profile;
+  uint16_t seqno;
+};
+
+static struct abc_conn abc;
+static struct etimer et;
+static uint8_t rx_profile;
+static uint16_t rx_frames;
+static uint16_t rx_sent; /* last seqno seen + 1 */
+
+PROCESS(phy_bench_process, "PHY benchmark");
+PROCESS(phy_bench_rx_process, "PHY benchmark receiver");
+AUTOSTART_PROCESSES(&phy_bench_process, &phy_bench_rx_process);
+/*---------------------------------------------------------------------------*/
+static void
+putu32(uint32_t v)
+{
+  char buf[11];
+  uint8_t i = sizeof(buf) - 1;
+
+  buf[i] = '\0';
+  do {
+    buf[--i] = '0' + v % 10;
+    v /= 10;
+  } while(v != 0);
+  putstring(&buf[i]);
+}
+/*---------------------------------------------------------------------------*/
+static void
+bench_send(uint8_t type, uint8_t profile, uint16_t seqno)
+{
+  struct bench_msg *msg;
+
+  packetbuf_clear();
+  msg = packetbuf_dataptr();
+  memset(msg, 0x55, BENCH_LEN);
+  msg->type = type;
+  msg->profile = profile;
+  msg->seqno = seqno;
+  packetbuf_set_datalen(type == BENCH_DATA ? BENCH_LEN : sizeof(*msg));
+  abc_send(&abc);
+}
+/*---------------------------------------------------------------------------*/
+static void
+abc_recv(struct abc_conn *c)
+{
+  struct bench_msg *msg = packetbuf_dataptr();
+
+  if(msg->type == BENCH_START) {
+    rx_profile = msg->profile;
+    process_post(&phy_bench_rx_process, PROCESS_EVENT_CONTINUE, NULL);
+  } else if(msg->type == BENCH_DATA && msg->profile == rx_profile) {
+    rx_frames++;
+    rx_sent = msg->seqno + 1;
+  }
+}
+static const struct abc_callbacks abc_call = {abc_recv};
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(phy_bench_rx_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  while(1) {
+    PROCESS_WAIT_EVENT_UNTIL(ev == PROCESS_EVENT_CONTINUE);
+
+    rx_frames = 0;
+    rx_sent = 0;
+    cc1101_rf_set_phy(rx_profile);
+    etimer_set(&et, BENCH_WINDOW);
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+    cc1101_rf_set_phy(CC1101_RF_CONF_PHY);
+
+    putstring("phy ");
+    putdec(rx_profile);
+    putstring(" rx ");
+    putu32(rx_frames);
+    putstring("/");
+    putu32(rx_sent);
+    putstring("\n");
+  }
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(phy_bench_process, ev, data)
+{
+  static uint8_t profile;
+  static uint16_t i;
+  static rtimer_clock_t last;
+  static uint32_t elapsed;
+  static struct etimer wait;
+  rtimer_clock_t now;
+
+  PROCESS_EXITHANDLER(abc_close(&abc);)
+
+  PROCESS_BEGIN();
+
+  abc_open(&abc, 129, &abc_call);
+
+  while(1) {
+    PROCESS_WAIT_EVENT_UNTIL(ev == sensors_event && data == &button1);
+    leds_on(LEDS_GREEN);
+
+    for(profile = 0; profile < CC1101_RF_PHY_COUNT; profile++) {
+      bench_send(BENCH_START, profile, 0);
+
+      // let the receiver switch first
+      etimer_set(&wait, CLOCK_SECOND / 2);
+      PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&wait));
+      etimer_set(&wait, BENCH_WINDOW);
+
+      cc1101_rf_set_phy(profile);
+      /*
+       * The 16 bit rtimer wraps every 4 s: add up the ticks frame by
+       * frame, every frame takes far less than that
+       */
+      elapsed = 0;
+      last = RTIMER_NOW();
+      for(i = 0; elapsed < BENCH_TIME; i++) {
+        bench_send(BENCH_DATA, profile, i);
+        PROCESS_PAUSE();
+        now = RTIMER_NOW();
+        elapsed += (rtimer_clock_t)(now - last);
+        last = now;
+      }
+      cc1101_rf_set_phy(CC1101_RF_CONF_PHY);
+
+      putstring("phy ");
+      putdec(profile);
+      putstring(" tx ");
+      putu32(i);
+      putstring(" frames ");
+      // RTIMER_ARCH_SECOND is 625 * 25: keep the product below 2^32
+      putu32((uint32_t)i * BENCH_LEN * (RTIMER_ARCH_SECOND / 25) / (elapsed / 25));
+      putstring(" bytes/s\n");
+
+      // the receiver goes back to the boot profile when the window ends
+      PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&wait));
+    }
+
+    leds_off(LEDS_GREEN);
+  }
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
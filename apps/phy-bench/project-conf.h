@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+#ifndef PROJECT_CONF_H_
+#define PROJECT_CONF_H_
+
+#define STARTUP_CONF_VERBOSE 0
+
+// measure the PHY alone: no duty cycling, radio always on
+#define NETSTACK_CONF_RDC nullrdc_noframer_driver
+
+#define NETSTACK_CONF_MAC nullmac_driver
+
+#define CHAMELEON_CONF_MODULE chameleon_raw
+
+// disable energester
+#define ENERGEST_CONF_ON 0
+
+#endif /* PROJECT_CONF_H_ */
@@ -0,0 +1,131 @@
+/**
+ * \file
+ *         Host simulation of the per neighbor TX power selection
+ *         (cpu/cc1110/net/link-power.c) against the fixed -5 dBm setting.
+ *
+ *         One node talks to neighbors at growing path loss. Every round the
+ *         neighbor sends us a frame at -5 dBm, so we learn the loss of the
+ *         link, then we send it a frame and retry up to MAX_TX times. A frame
+ *         arrives when its power at the receiver, with +/- FADING dB of
+ *         random fading, is above SENSITIVITY.
+ *
+ *         The energy per delivered packet is the TX current of the level
+ *         times 3 V times the airtime of the frame, summed over the retries.
+ *
+ *         make TARGET=native && ./txpower-sim.native
+ *
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+
+#include "contiki.h"
+#include "lib/random.h"
+#include "link-power.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define ROUNDS       1000
+#define MAX_TX       5
+#define SENSITIVITY  -103   /* dBm, 38.4 kbps */
+#define FADING       4      /* dB */
+#define AIRTIME_US   10600  /* 51 bytes on air at 38.4 kbps */
+#define VOLTS        3
+
+/* CC1110 TX current for every link power level, mA (SWRS033G, 868 MHz) */
+static const uint8_t tx_ma[LINK_POWER_LEVELS] = { 13, 14, 15, 17, 26 };
+
+/* Path loss of the simulated neighbors, dB */
+static const uint8_t path_loss[] = { 55, 65, 75, 85, 92, 98, 102 };
+#define NEIGHBORS (sizeof(path_loss) / sizeof(path_loss[0]))
+
+struct result {
+  unsigned long sent;
+  unsigned long delivered;
+  unsigned long uj;
+};
+
+PROCESS(txpower_sim_process, "TX power simulation");
+AUTOSTART_PROCESSES(&txpower_sim_process);
+/*---------------------------------------------------------------------------*/
+static int
+fading(void)
+{
+  return (int)(random_rand() % (2 * FADING + 1)) - FADING;
+}
+/*---------------------------------------------------------------------------*/
+/* Send one packet at 'level', retrying, and account for it */
+static void
+send(struct result *r, uint8_t level, uint8_t loss)
+{
+  uint8_t tx;
+
+  for(tx = 0; tx < MAX_TX; tx++) {
+    r->sent++;
+    r->uj += (unsigned long)tx_ma[level] * VOLTS * AIRTIME_US / 1000;
+    if(link_power_dbm[level] - loss + fading() >= SENSITIVITY) {
+      r->delivered++;
+      return;
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static unsigned long
+per_packet(struct result *r)
+{
+  return r->delivered ? r->uj / r->delivered : 0;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(txpower_sim_process, ev, data)
+{
+  static struct result fixed, adaptive, fixed_all, adaptive_all;
+  rimeaddr_t addr;
+  unsigned int n, round;
+  int rssi;
+
+  PROCESS_BEGIN();
+
+  random_init(0x1234);
+
+  printf("loss  | fixed -5 dBm: delivered  uJ/pkt | adaptive: dBm  delivered  uJ/pkt\n");
+
+  for(n = 0; n < NEIGHBORS; n++) {
+    addr.u8[0] = 0x10;
+    addr.u8[1] = n + 1;
+    fixed = (struct result){0, 0, 0};
+    adaptive = fixed;
+
+    for(round = 0; round < ROUNDS; round++) {
+      // the neighbor talks to us first: learn the link
+      rssi = link_power_dbm[LINK_POWER_DEFAULT] - path_loss[n] + fading();
+      if(rssi >= SENSITIVITY) {
+        link_power_update(&addr, link_power_dbm[LINK_POWER_DEFAULT], rssi, 10);
+      }
+
+      send(&fixed, LINK_POWER_DEFAULT, path_loss[n]);
+      send(&adaptive, link_power_level(&addr), path_loss[n]);
+    }
+
+    printf("%3d dB |        %4lu/%4d  %6lu |      %+3d   %4lu/%4d  %6lu\n",
+           path_loss[n],
+           fixed.delivered, ROUNDS, per_packet(&fixed),
+           link_power_dbm[link_power_level(&addr)],
+           adaptive.delivered, ROUNDS, per_packet(&adaptive));
+
+    fixed_all.sent += fixed.sent;
+    fixed_all.delivered += fixed.delivered;
+    fixed_all.uj += fixed.uj;
+    adaptive_all.sent += adaptive.sent;
+    adaptive_all.delivered += adaptive.delivered;
+    adaptive_all.uj += adaptive.uj;
+  }
+
+  printf("all    |        %5lu  %6lu |            %5lu  %6lu\n",
+         fixed_all.delivered, per_packet(&fixed_all),
+         adaptive_all.delivered, per_packet(&adaptive_all));
+
+  exit(0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
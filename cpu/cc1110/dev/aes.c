@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         AES-128 coprocessor driver, see aes.h
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#include "contiki.h"
+#include "dev/aes.h"
+#include "dev/dma.h"
+#include "cc1110.h"
+#include "sfr-bits.h"
+
+#include <string.h>
+
+/* Built only when the platform gives the coprocessor its DMA channels */
+#ifdef DMA_AES_OUT_CHANNEL
+
+/* Last partial block, zero padded */
+static __xdata uint8_t pad[AES_BLOCK_LEN];
+/*---------------------------------------------------------------------------*/
+static void
+aes_load(uint8_t cmd, const uint8_t *block)
+{
+    uint8_t i;
+
+    ENCCS = cmd | ENCCS_ST;
+    for(i = 0; i < AES_BLOCK_LEN; i++)
+    {
+        ENCDI = block[i];
+    }
+    while(!(ENCCS & ENCCS_RDY));
+}
+/*---------------------------------------------------------------------------*/
+static void
+dma_setup(uint8_t c, uint16_t src, uint16_t dst, uint8_t len, uint8_t trigger,
+          uint8_t inc)
+{
+    dma_conf[c].src_h = src >> 8;
+    dma_conf[c].src_l = src;
+    dma_conf[c].dst_h = dst >> 8;
+    dma_conf[c].dst_l = dst;
+    dma_conf[c].len_h = DMA_VLEN_LEN;
+    dma_conf[c].len_l = len;
+    dma_conf[c].wtt = DMA_BLOCK | trigger;
+    // below the radio channels, a frame on air must not wait for us
+    dma_conf[c].inc_prio = inc | DMA_PRIO_LOW;
+}
+/*---------------------------------------------------------------------------*/
+/*
+ * One block through the coprocessor, the result goes to 'out' unless it
+ * is NULL (CBC-MAC keeps it inside). CTR and the other stream modes take
+ * 32 bits at a time and ask for the next ones only after the previous
+ * result has been read out, so the channels are armed once per word.
+ */
+static void
+aes_block(uint8_t mode, const uint8_t *in, uint8_t *out)
+{
+    uint8_t chunk;
+    uint8_t mask;
+    uint8_t i;
+
+    chunk = (mode == ENCCS_MODE_CTR) ? 4 : AES_BLOCK_LEN;
+    mask = (1 << DMA_AES_IN_CHANNEL);
+    if(out)
+    {
+        mask |= (1 << DMA_AES_OUT_CHANNEL);
+    }
+
+    for(i = 0; i < AES_BLOCK_LEN; i += chunk)
+    {
+        dma_setup(DMA_AES_IN_CHANNEL, (uint16_t)(in + i), (uint16_t)&X_ENCDI,
+                  chunk, DMA_T_ENC_DW, DMA_SRC_INC_1 | DMA_DST_INC_NO);
+        if(out)
+        {
+            dma_setup(DMA_AES_OUT_CHANNEL, (uint16_t)&X_ENCDO, (uint16_t)(out + i),
+                      chunk, DMA_T_ENC_UP, DMA_SRC_INC_NO | DMA_DST_INC_1);
+        }
+        DMAARM |= mask;
+
+        // the coprocessor requests the data as soon as it is started
+        if(i == 0)
+        {
+            ENCCS = mode | ENCCS_CMD_ENC | ENCCS_ST;
+        }
+        while(DMAARM & mask);
+    }
+
+    while(!(ENCCS & ENCCS_RDY));
+}
+/*---------------------------------------------------------------------------*/
+void
+aes_set_key(const uint8_t *key)
+{
+    aes_load(ENCCS_CMD_KEY, key);
+}
+/*---------------------------------------------------------------------------*/
+void
+aes_ctr(const uint8_t *ctr, uint8_t *buf, uint8_t len)
+{
+    aes_load(ENCCS_MODE_CTR | ENCCS_CMD_IV, ctr);
+
+    for(; len >= AES_BLOCK_LEN; len -= AES_BLOCK_LEN, buf += AES_BLOCK_LEN)
+    {
+        aes_block(ENCCS_MODE_CTR, buf, buf);
+    }
+
+    if(len)
+    {
+        memset(pad, 0, AES_BLOCK_LEN);
+        memcpy(pad, buf, len);
+        aes_block(ENCCS_MODE_CTR, pad, pad);
+        memcpy(buf, pad, len);
+    }
+}
+/*---------------------------------------------------------------------------*/
+void
+aes_cbc_mac(const uint8_t *b0, const uint8_t *buf, uint8_t len, uint8_t *mac)
+{
+    const uint8_t *in;
+
+    memset(pad, 0, AES_BLOCK_LEN);
+    aes_load(ENCCS_MODE_CBCMAC | ENCCS_CMD_IV, pad);
+
+    // all the blocks but the last one in CBC-MAC mode, the last in CBC
+    // mode gives out the tag
+    in = b0;
+    while(len)
+    {
+        aes_block(ENCCS_MODE_CBCMAC, in, NULL);
+
+        if(len >= AES_BLOCK_LEN)
+        {
+            in = buf;
+            buf += AES_BLOCK_LEN;
+            len -= AES_BLOCK_LEN;
+        }
+        else
+        {
+            memcpy(pad, buf, len);
+            in = pad;
+            len = 0;
+        }
+    }
+    aes_block(ENCCS_MODE_CBC, in, mac);
+}
+/*---------------------------------------------------------------------------*/
+#endif /* DMA_AES_OUT_CHANNEL */
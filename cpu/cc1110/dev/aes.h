@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         AES-128 coprocessor of the cc1110.
+ *
+ *         The data goes in and out of the coprocessor with the DMA
+ *         channels DMA_AES_IN_CHANNEL and DMA_AES_OUT_CHANNEL, the CPU only
+ *         loads the key and the IV and re-arms the channels between the
+ *         blocks. Buffers must be in xdata, where the DMA can reach them.
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#ifndef AES_H_
+#define AES_H_
+
+#include "contiki.h"
+
+#define AES_BLOCK_LEN 16
+
+/* Load a 16 bytes key, used until the next call */
+void aes_set_key(const uint8_t *key);
+
+/*
+ * CTR mode, in place: 'ctr' is the first counter block, the coprocessor
+ * increments it for the following blocks. Decryption is the same call.
+ */
+void aes_ctr(const uint8_t *ctr, uint8_t *buf, uint8_t len);
+
+/*
+ * CBC-MAC of the block 'b0' followed by 'buf' zero padded to a block
+ * boundary. The 16 bytes tag goes to 'mac'.
+ */
+void aes_cbc_mac(const uint8_t *b0, const uint8_t *buf, uint8_t len,
+                 uint8_t *mac);
+
+#endif /* AES_H_ */
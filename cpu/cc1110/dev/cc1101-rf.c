@@ -1,663 +1,1669 @@
-/*
- * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
- * All rights reserved.
- *
- */
-
-/**
- * \file
- *         Implementation of the radio driver for the cc1110.
- *
- *
- *
- * \author
- *         Attilio Dona' - <piccino.lab@gmail.com>
- */
-
-
-#include "contiki.h"
-#include "dev/radio.h"
-#include "dev/cc1101-rf.h"
-#include "cc1110.h"
-#include "sfr-bits.h"
-#include "sys/clock.h"
-#include "sys/rtimer.h"
-#include "dev/dma.h"
-#include "net/packetbuf.h"
-#include "net/rime/rimestats.h"
-#include "net/rime/rimeaddr.h"
-#include "net/netstack.h"
-
-#include <string.h>
-
-/*---------------------------------------------------------------------------*/
-#define CHECKSUM_LEN 2
-/*---------------------------------------------------------------------------*/
-
-#if RF_CONF_LEDS
-#define RF_LEDS RF_CONF_LEDS
-#else
-#define RF_LEDS 0
-#endif
-
-#if RF_LEDS
-#include "dev/leds.h"
-#define RF_RX_LED_ON()		leds_on(LEDS_RED);
-#define RF_RX_LED_OFF()		leds_off(LEDS_RED);
-#define RF_TX_LED_ON()		leds_on(LEDS_GREEN);
-#define RF_TX_LED_OFF()		leds_off(LEDS_GREEN);
-#else
-#define RF_RX_LED_ON()
-#define RF_RX_LED_OFF()
-#define RF_TX_LED_ON()
-#define RF_TX_LED_OFF()
-#endif
-/*---------------------------------------------------------------------------*/
-#define DEBUG 0
-#if DEBUG
-#include <stdio.h>
-#include "debug.h"
-#define PUTSTRING(...) putstring(__VA_ARGS__)
-#define PUTHEX(...) puthex(__VA_ARGS__)
-#define PRINTF(...) printf(__VA_ARGS__)
-#else
-#define PUTSTRING(...)
-#define PUTHEX(...)
-#define PRINTF(...)
-#endif
-
-/*---------------------------------------------------------------------------*/
-/* Local RF Flags */
-#define RX_ACTIVE  0x80
-#define WAS_OFF    0x10
-#define RF_ON      0x01
-
-
-/* Bit Masks for the last byte in the RX FIFO */
-#define CRC_BIT_MASK 0x80
-#define LQI_BIT_MASK 0x7F
-/* RSSI Offset */
-#define RSSI_OFFSET    73
-
-/* 192 ms, radio off -> on interval */
-#define ONOFF_TIME                    RTIMER_ARCH_SECOND / 3125
-
-
-/*---------------------------------------------------------------------------*/
-static uint8_t CC_AT_DATA rf_flags;
-static uint8_t CC_AT_DATA packet_pending;
-
-static int on(void); /* prepare() needs our prototype */
-static int off(void); /* transmit() needs our prototype */
-static int channel_clear(void); /* transmit() needs our prototype */
-/*---------------------------------------------------------------------------*/
-
-
-static uint8_t radiobuff[(PACKETBUF_SIZE + PACKETBUF_HDR_SIZE)];
-
-
-/*---------------------------------------------------------------------------*/
-/* Netstack API radio driver functions */
-/*---------------------------------------------------------------------------*/
-static int
-init(void)
-{
-    // dma packet buffer data pointer
-    void *packetptr;
-
-    PUTSTRING("RF: Init\n");
-
-    if(rf_flags & RF_ON)
-    {
-        return 0;
-    }
-
-    /**
-     * CC1101 configuration registers - Default values extracted from SmartRF Studio
-     *
-     * Configuration:
-     *
-     * Deviation = 20.629883
-     * Base frequency = 868.299866
-     * Carrier frequency = 868.299866
-     * Channel number = 0
-     * Modulated = true
-     * Modulation format = GFSK
-     * Manchester enable = false
-     * Data whitening = off
-     * Sync word qualifier mode = 30/32 sync word bits detected
-     * Preamble count = 4
-     * Channel spacing = 199.951172
-     * Carrier frequency = 867.999939
-     * Data rate = 38.3835 Kbps
-     * RX filter BW = 101.562500
-     * Data format = Normal mode
-     * Length config = Variable packet length mode. Packet length configured by the first byte after sync word
-     * CRC enable = true
-     * Packet length = 255
-     * Device address = 1
-     * Address config = Enable address check
-     * Append status = Append two status bytes to the payload of the packet. The status bytes contain RSSI and
-     * LQI values, as well as CRC OK
-     * CRC autoflush = false
-     * PA ramping = false
-     * TX power = 7
-     * Settings optimized for high sensitivity
-     */
-    PKTCTRL0  = 0x05; // packet automation control
-    FSCTRL1   = 0x06; // frequency synthesizer control
-
-#ifdef FREQ_868MHZ
-    FREQ2     = 0x21; // frequency control word, high byte
-    FREQ1     = 0x62; // frequency control word, middle byte
-    FREQ0     = 0x76; // frequency control word, low byte
-#else
-    // Base frequency = 901.999969
-    FREQ2     = 0x22; // frequency control word, high byte
-    FREQ1     = 0xB1; // frequency control word, middle byte
-    FREQ0     = 0x3B; // frequency control word, low byte
-#endif
-    MDMCFG4   = 0xCA; // modem configuration
-    MDMCFG3   = 0x83; // modem configuration
-    MDMCFG2   = 0x13; // modem configuration
-    DEVIATN   = 0x35; // modem deviation setting
-    MCSM0     = 0x18; // main radio control state machine configuration
-    FOCCFG    = 0x16; // frequency offset compensation configuration
-    AGCCTRL2  = 0x43; // agc control
-    FSCAL3    = 0xE9; // frequency synthesizer calibration
-    FSCAL2    = 0x2A; // frequency synthesizer calibration
-    FSCAL1    = 0x00; // frequency synthesizer calibration
-    FSCAL0    = 0x1F; // frequency synthesizer calibration
-    TEST1     = 0x31; // various test settings
-    TEST0     = 0x09; // various test settings
-    //PA_TABLE0 = 0xCB; // pa power setting 0: +7 dbm
-    PA_TABLE0 = 0x8F; // pa power setting 0: -5 dbm
-
-
-    /* TEST1	Various Test Settings
-     Always set this register to 0x31 when being in TX. At low data rates, the
-     sensitivity can be improved by changing it to 0x35 in RX.
-     (MDMCFG2.DEM_DCFILT_OFF should be 0).
-    */
-
-    //SYNC1 = 0xD3; /* Sync Word, High Byte */
-    //SYNC0 = 0x91; /* Sync Word, Low Byte */
-
-    SYNC1 = 0xB5; /* Sync Word, High Byte */
-    SYNC0 = 0x47; /* Sync Word, Low Byte */
-    PKTLEN = 0xFF; /* Packet Length */
-
-
-    /* The reset default value
-     * Packet Automation Control: PQT == 0 => sync word always accepted
-     * APPEND_STATUS = 1
-     * no hw address check
-     */
-    //PKTCTRL1 = 0x04;
-
-    //ADDR = 0x00; /* ADDR		Device Address */
-
-    /* MCSM2	Main Radio Control State Machine Configuration
-
-       UNUSED RX_TIME_RSSI RX_TIME_QUAL RX_TIME[2:0]
-         000     0              0          111
-
-       RX_TIME[2:0] Timeout for sync word search in RX. The timeout is relative to the
-                    programmed tEvent0.
-                    111: Until end of packet
-    */
-    //MCSM2 = 0x07; // the default value
-
-    /* MCSM1	Main Radio Control State Machine Configuration
-
-       UNUSED CCA_MODE RXOFF_MODE TXOFF_MODE
-         00     11         11          00
-
-        CCA_MODE[1:0] Selects CCA_MODE; Reflected in CCA signal
-                      11: If RSSI below threshold unless currently receiving a packet
-
-        RXOFF_MODE[1:0] Select what should happen (next state) when a packet has been received
-                        11: Stay in RX
-
-        TXOFF_MODE[1:0] Select what should happen (next state) when a packet has been sent (TX)
-                        11: RX
-    */
-    MCSM1 = 0x3F;
-
-    /* MCSM0	Main Radio Control State Machine Configuration
-
-       UNUSED  FS_AUTOCAL[1:0]  RESERVD  CLOSE_IN_RX[1:0]
-         00      11             10        00
-
-       FS_AUTOCAL=11 Calibration mode: Every 4th time when going from RX or TX to IDLE automatically
-    */
-    //MCSM0 = 0x38; // calibrate Every 4th time when going from RX or TX to IDLE automatically
-
-
-    /*
-     * GDO0_CFG[5:0] : 001001 CCA high when RSSI level is below threshold on P1_5
-     */
-    //IOCFG0 = 0x09;
-
-    /*
-    configure the channel for RADIO
-    */
-    dma_conf[DMA_RADIO_CHANNEL].src_h = 0xDF;  //SFRX(X_RFD, 0xDFD9);
-    dma_conf[DMA_RADIO_CHANNEL].src_l = 0xD9;
-
-    dma_conf[DMA_RADIO_CHANNEL].dst_h = ((uint16_t)radiobuff)>>8;
-    dma_conf[DMA_RADIO_CHANNEL].dst_l = (uint8_t)radiobuff;
-
-    /*
-    packetptr = packetbuf_dataptr();
-    dma_conf[DMA_RADIO_CHANNEL].dst_h = ((uint16_t)packetptr)>>8;
-    dma_conf[DMA_RADIO_CHANNEL].dst_l = (uint8_t)packetptr;
-    */
-
-    dma_conf[DMA_RADIO_CHANNEL].len_l = DMA_VLEN_N3;
-    dma_conf[DMA_RADIO_CHANNEL].len_h = PACKETBUF_SIZE;
-    dma_conf[DMA_RADIO_CHANNEL].wtt = DMA_SINGLE | DMA_T_RADIO;
-    dma_conf[DMA_RADIO_CHANNEL].inc_prio = DMA_DST_INC_1 | DMA_IRQ_MASK_ENABLE | DMA_PRIO_HIGH;
-
-    //memcpy(&dma_conf[DMA_RADIO_CHANNEL].dst_h, &packetbuf_dataptr(), 2);
-
-    // enable DMA interrupt
-    IEN1 |= DMAIE;
-
-    RF_TX_LED_OFF();
-    RF_RX_LED_OFF();
-
-    // enable RFIF interrupt
-    //RFIM = IM_DONE|IM_RXOVF;
-    //IEN2 |= IEN2_RFIE;
-
-    rf_flags |= RF_ON;
-
-    PUTSTRING("RF: Init DONE\n");
-
-    return 1;
-}
-
-/*
- prepare not needed for this driver
-*/
-static int
-prepare(const void *payload, unsigned short payload_len)
-{
-    payload;
-    payload_len;
-    return 0;
-}
-
-/*
- *
- */
-static int
-transmit(unsigned short transmit_len)
-{
-    uint8_t counter;
-    int ret = RADIO_TX_ERR;
-    rtimer_clock_t t0;
-    uint8_t *dataptr;
-
-    PRINTF("TX: %d\n", rf_flags);
-
-    if(!(rf_flags & RX_ACTIVE))
-    {
-        t0 = RTIMER_NOW();
-        on();
-        rf_flags |= WAS_OFF;
-        while(RTIMER_CLOCK_LT(RTIMER_NOW(), t0 + ONOFF_TIME));
-    }
-
-    if(channel_clear() == CC1110_RF_CCA_BUSY)
-    {
-        RIMESTATS_ADD(contentiondrop);
-        return RADIO_TX_COLLISION;
-    }
-
-    //PRINTF("setting TX\n");
-
-    // disable DMA channel 0 (RX)
-    DMA_ABORT(0);
-
-    /* Start the transmission */
-    RF_TX_LED_ON();
-    ENERGEST_OFF(ENERGEST_TYPE_LISTEN);
-    ENERGEST_ON(ENERGEST_TYPE_TRANSMIT);
-
-    RFST = STX;
-
-    // send the packet
-    dataptr = packetbuf_hdrptr();
-
-    /* SWRS033G
-     * The packet length is defined as the
-    * payload data, excluding the length byte and
-    * the optional CRC
-    */
-
-    while(MARCSTATE != TX_STATE) {}
-
-    PRINTF("mcs: %2X, len:%d, RF:%d\n", MARCSTATE, transmit_len, RFIF);
-
-    // Print the crystal status
-    PRINTF("dptr: %4X\n", dataptr);
-
-    for(counter=0; counter<transmit_len; counter++)
-    {
-        PRINTF("[%d]", dataptr[counter]);
-    }
-    while(!RFTXRXIF);
-    RFTXRXIF = 0;
-    RFD = transmit_len;
-    for(counter=0; counter<transmit_len; counter++)
-    {
-        while(!RFTXRXIF); // wait radio to be TX ready
-        RFTXRXIF = 0;
-        RFD = dataptr[counter];
-
-    }
-    while (!(RFIF & IRQ_DONE)) {}
-
-    PRINTF("\nTX OK:%d\n", RFIF);
-
-    ret = RADIO_TX_OK;
-
-    ENERGEST_OFF(ENERGEST_TYPE_TRANSMIT);
-    ENERGEST_ON(ENERGEST_TYPE_LISTEN);
-
-    if(rf_flags & WAS_OFF)
-    {
-        off();
-    }
-    else
-    {
-        // enable DMA channel 0 (RX)
-        DMA_ARM(0);
-    }
-
-    RIMESTATS_ADD(lltx);
-
-    RF_TX_LED_OFF();
-
-    /* OK, sent. We are now ready to send more */
-    return ret;
-}
-
-/*---------------------------------------------------------------------------*/
-static int
-send(void *payload, unsigned short payload_len)
-{
-    //prepare(payload, payload_len);
-    return transmit(payload_len);
-}
-
-/*
- * Read the received packet from the radio.
- *
- *
- */
-read(void *buf, unsigned short bufsize)
-{
-
-    uint8_t pktlen;
-
-    // when a packet is read it is no more pending, so another packet may be processed by DMA
-    packet_pending = 0;
-    /*
-      pktlen = *(uint8_t*)packetbuf_dataptr();
-      if(packetbuf_hdrreduce(sizeof(pktlen)) == 0) {
-        PUTSTRING("chameleon-raw: too short packet\n");
-        return 0;
-      }
-    */
-
-    pktlen = radiobuff[0];
-
-    memcpy(buf,radiobuff+1,pktlen);
-
-    // TODO: get the status bytes and set the packet attributes
-    // PACKETBUF_ATTR_LINK_QUALITY and PACKETBUF_ATTR_RSSI
-
-    // (re)ARM the channel for the next packet
-    DMA_ARM(0);
-
-    return pktlen;
-}
-
-#if 0
-static int
-read(void *buf, unsigned short bufsize)
-{
-    uint8_t i;
-    uint8_t len;
-    uint8_t crc_corr;
-    int8_t rssi;
-
-    PUTSTRING("RF: Read\n");
-
-    /* Check the length */
-    while(!RFTXRXIF); // wait packet ready
-    len = RFD;
-
-    /* Check for validity */
-    if(len > CC1110_RF_MAX_PACKET_LEN)
-    {
-        /* if here, the best assumption is that we must be out of sync. */
-        PUTSTRING("RF: bad sync\n");
-
-        RIMESTATS_ADD(badsynch);
-        //CC2530_CSP_ISFLUSHRX();
-        return 0;
-    }
-
-    if(len <= CC1110_RF_MIN_PACKET_LEN)
-    {
-        PUTSTRING("RF: too short\n");
-
-        RIMESTATS_ADD(tooshort);
-        //CC2530_CSP_ISFLUSHRX();
-        return 0;
-    }
-
-    if(len - CHECKSUM_LEN > bufsize)
-    {
-        PUTSTRING("RF: too long\n");
-
-        RIMESTATS_ADD(toolong);
-        //CC2530_CSP_ISFLUSHRX();
-        return 0;
-    }
-
-#if CC1110_RF_CONF_HEXDUMP
-    /* If we reach here, chances are the FIFO is holding a valid frame */
-    io_arch_writeb(magic[0]);
-    io_arch_writeb(magic[1]);
-    io_arch_writeb(magic[2]);
-    io_arch_writeb(magic[3]);
-    io_arch_writeb(len);
-#endif
-
-    RF_RX_LED_ON();
-
-    PUTSTRING("RF: read (0x");
-    PUTHEX(len);
-    PUTSTRING(" bytes) = ");
-    len -= CHECKSUM_LEN;
-    for(i = 0; i < len; ++i)
-    {
-        while(!RFTXRXIF); // wait byte packet ready to read
-        ((unsigned char *)(buf))[i] = RFD;
-#if CC1110_RF_CONF_HEXDUMP
-        io_arch_writeb(((unsigned char *)(buf))[i]);
-#endif
-        PUTHEX(((unsigned char *)(buf))[i]);
-    }
-    PUTSTRING("\n");
-
-    /* Read the RSSI and CRC/Corr bytes */
-    while(!RFTXRXIF); // wait packet ready
-    rssi = ((int8_t) RFD) - RSSI_OFFSET;
-    while(!RFTXRXIF); // wait packet ready
-    crc_corr = RFD;
-
-#if CC1110_RF_CONF_HEXDUMP
-    io_arch_writeb(rssi);
-    io_arch_writeb(crc_corr);
-    io_arch_flush();
-#endif
-
-    /* MS bit CRC OK/Not OK, 7 LS Bits, Correlation value */
-    if(crc_corr & CRC_BIT_MASK)
-    {
-        packetbuf_set_attr(PACKETBUF_ATTR_RSSI, rssi);
-        packetbuf_set_attr(PACKETBUF_ATTR_LINK_QUALITY, crc_corr & LQI_BIT_MASK);
-        RIMESTATS_ADD(llrx);
-    }
-    else
-    {
-        RIMESTATS_ADD(badcrc);
-        //CC2530_CSP_ISFLUSHRX();
-        RF_RX_LED_OFF();
-        return 0;
-    }
-
-    RF_RX_LED_OFF();
-
-    return (len);
-}
-#endif
-
-/*---------------------------------------------------------------------------*/
-static int
-channel_clear(void)
-{
-#if 0
-    if(P1_5)
-    {
-        return CC1110_RF_CCA_CLEAR;
-    }
-    return CC1110_RF_CCA_BUSY;
-#endif
-    return (PKTSTATUS & PKTSTATUS_CCA);
-}
-
-/*---------------------------------------------------------------------------*/
-static int
-receiving_packet(void)
-{
-    PUTSTRING("RF: Receiving\n");
-
-    /*
-     * SFD high while transmitting and receiving.
-     * TX_ACTIVE high only when transmitting
-     *
-     * FSMSTAT1 & (TX_ACTIVE | SFD) == SFD <=> receiving
-     */
-    return (PKTSTATUS & PKTSTATUS_SFD);
-}
-
-/*---------------------------------------------------------------------------*/
-static int
-pending_packet(void)
-{
-    return packet_pending;
-}
-
-/*---------------------------------------------------------------------------*/
-static int on(void)
-{
-    PUTSTRING("RF: switching RADIO on\n");
-
-    if (!(rf_flags & RX_ACTIVE))
-    {
-        PRINTF("mcst-on-0: %X\n", MARCSTATE);
-        switch (MARCSTATE)
-        {
-        case IDLE_STATE:
-            RFST = SRX;
-            break;
-        case RX_STATE:
-            break;
-        default:
-            /* if in an unexpected state reset the radio
-               and go to RX
-            */
-            RFST = SIDLE;
-            while(MARCSTATE!=IDLE_STATE);
-            RFST = SRX;
-        }
-
-        // wait RX state
-        //while(MARCSTATE!=RX_STATE);
-
-        // ARM the DMA radio channel
-        DMA_ARM(0);
-
-        rf_flags |= RX_ACTIVE;
-    }
-
-    PRINTF("mcst-on-1: %X\n", MARCSTATE);
-    ENERGEST_ON(ENERGEST_TYPE_LISTEN);
-    return 1;
-}
-
-/*
- * Radio is switched off
- */
-static int
-off(void)
-{
-    RFST = SIDLE;
-    rf_flags &= ~RX_ACTIVE;
-
-    // Abort the DMA radio channel
-    DMA_ABORT(0);
-
-    ENERGEST_OFF(ENERGEST_TYPE_LISTEN);
-    return 1;
-}
-
-// For what I understand from the data sheet this is invoked if and only if a complete packet is received
-void rf_dma_callback_isr(void)
-{
-    packet_pending = 1;
-}
-
-#if 0
-/* avoid referencing bits since we're not using them */
-#pragma save
-#if CC_CONF_OPTIMIZE_STACK_SIZE
-#pragma exclude bits
-#endif
-void
-rfif_isr(void) __interrupt(RF_VECTOR)
-{
-    ENERGEST_ON(ENERGEST_TYPE_IRQ);
-
-    if(RFIF & IRQ_DONE)
-    {
-
-    }
-
-    ENERGEST_OFF(ENERGEST_TYPE_IRQ);
-}
-#pragma restore
-#endif
-
-/*---------------------------------------------------------------------------*/
-const struct radio_driver cc1101_rf_driver =
-{
-    init,
-    prepare,
-    transmit,
-    send,
-    read,
-    channel_clear,
-    receiving_packet,
-    pending_packet,
-    on,
-    off,
-};
-/*---------------------------------------------------------------------------*/
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Implementation of the radio driver for the cc1110.
+ *
+ *
+ *
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+
+
+#include "contiki.h"
+#include "dev/radio.h"
+#include "dev/cc1101-rf.h"
+#include "cc1110.h"
+#include "sfr-bits.h"
+#include "sys/clock.h"
+#include "sys/rtimer.h"
+#include "dev/dma.h"
+#include "net/packetbuf.h"
+#include "net/packetbuf-swap.h"
+#include "net/rime/rimestats.h"
+#include "net/rime/rimeaddr.h"
+#include "net/netstack.h"
+#include "lib/random.h"
+#if CC1101_RF_CONF_TX_POWER
+#include "net/link-power.h"
+#endif
+
+#include <string.h>
+
+/*---------------------------------------------------------------------------*/
+#define CHECKSUM_LEN 2
+/*---------------------------------------------------------------------------*/
+
+#if RF_CONF_LEDS
+#define RF_LEDS RF_CONF_LEDS
+#else
+#define RF_LEDS 0
+#endif
+
+#if RF_LEDS
+#include "dev/leds.h"
+#define RF_RX_LED_ON()		leds_on(LEDS_RED);
+#define RF_RX_LED_OFF()		leds_off(LEDS_RED);
+#define RF_TX_LED_ON()		leds_on(LEDS_GREEN);
+#define RF_TX_LED_OFF()		leds_off(LEDS_GREEN);
+#else
+#define RF_RX_LED_ON()
+#define RF_RX_LED_OFF()
+#define RF_TX_LED_ON()
+#define RF_TX_LED_OFF()
+#endif
+/*---------------------------------------------------------------------------*/
+#define DEBUG 0
+#if DEBUG
+#include <stdio.h>
+#include "debug.h"
+#define PUTSTRING(...) putstring(__VA_ARGS__)
+#define PUTHEX(...) puthex(__VA_ARGS__)
+#define PRINTF(...) printf(__VA_ARGS__)
+#else
+#define PUTSTRING(...)
+#define PUTHEX(...)
+#define PRINTF(...)
+#endif
+
+/*---------------------------------------------------------------------------*/
+/* Local RF Flags */
+#define RX_ACTIVE  0x80
+#define WAS_OFF    0x10
+#define RF_ON      0x01
+
+
+/* Bit Masks for the last byte in the RX FIFO */
+#define CRC_BIT_MASK 0x80
+#define LQI_BIT_MASK 0x7F
+/* RSSI Offset */
+#define RSSI_OFFSET    73
+
+/* 192 ms, radio off -> on interval */
+#define ONOFF_TIME                    RTIMER_ARCH_SECOND / 3125
+
+/*
+ * Listen before talk: a busy channel is checked again LBT_RETRIES times,
+ * after a random backoff drawn from a window of LBT_BACKOFF rtimer ticks
+ * that doubles at every retry
+ */
+#ifdef CC1101_RF_CONF_LBT_RETRIES
+#define LBT_RETRIES CC1101_RF_CONF_LBT_RETRIES
+#else
+#define LBT_RETRIES 4
+#endif
+
+#ifdef CC1101_RF_CONF_LBT_BACKOFF
+#define LBT_BACKOFF CC1101_RF_CONF_LBT_BACKOFF
+#else
+#define LBT_BACKOFF (RTIMER_ARCH_SECOND / 1000)
+#endif
+
+#define LBT_DELAY(tries) \
+    (1 + random_rand() % ((rtimer_clock_t)LBT_BACKOFF << (tries)))
+
+
+/*---------------------------------------------------------------------------*/
+static uint8_t CC_AT_DATA rf_flags;
+
+#ifdef DMA_RADIO_TX_CHANNEL
+#if CC1101_RF_CONF_TX_ASYNC
+#define TX_ASYNC 1
+#else
+#define TX_ASYNC 0
+#endif
+
+/* TX state machine, see transmit() */
+#define TX_IDLE      0
+#define TX_SETTLING  1 /* waiting ONOFF_TIME or the LBT backoff */
+#define TX_ON_AIR    2 /* STX strobed, waiting IRQ_DONE */
+
+static volatile uint8_t CC_AT_DATA tx_state;
+static volatile uint8_t tx_status;
+static uint8_t tx_tries; /* busy CCA so far */
+static struct rtimer tx_rtimer;
+static uint8_t *txptr; /* the length byte, then the frame */
+
+#if TX_ASYNC
+static uint8_t txbuf[1 + CC1110_RF_MAX_PACKET_LEN];
+static volatile uint8_t tx_done; /* outcome not reported yet */
+static cc1101_rf_tx_callback_t tx_callback;
+static rtimer_clock_t tx_repeat; /* 0, or how long to repeat the frame */
+static rtimer_clock_t tx_repeat_end;
+static volatile uint8_t tx_count; /* times on air */
+#endif
+#endif
+
+static int on(void); /* prepare() needs our prototype */
+static int off(void); /* transmit() needs our prototype */
+static int channel_clear(void); /* transmit() needs our prototype */
+#ifdef DMA_RADIO_TX_CHANNEL
+static void tx_on_air(void); /* tx_finish() needs our prototype */
+static void tx_settled(struct rtimer *t, void *ptr); /* tx_start() needs our prototype */
+#endif
+
+PROCESS(cc1101_rf_process, "CC1101 RF driver");
+/*---------------------------------------------------------------------------*/
+
+
+/*
+ * RX ring. The DMA channel writes into rxbuf[rx_head] while the frames
+ * waiting for read() sit from rx_tail onwards. When all the RX_SLOTS
+ * slots hold a frame the channel is left unarmed (rx_stalled): the radio
+ * overflows on the next frame, if one comes. rx_release() arms the channel
+ * again once a slot is free, and only takes the radio through IDLE when it
+ * has overflowed or is in the middle of a frame the channel missed.
+ *
+ * Every slot is a packetbuf storage area: the DMA puts the length byte
+ * just before the packetbuf data area, so the frame and the two status
+ * bytes land where packetbuf_dataptr() expects them and the slot can be
+ * swapped with the packetbuf storage without copying the frame. One slot
+ * takes the XDATA of the single receive buffer it replaces, but is full
+ * from the end of every frame until read() and loses the next one.
+ */
+#ifdef CC1101_RF_CONF_RX_SLOTS
+#define RX_SLOTS CC1101_RF_CONF_RX_SLOTS
+#else
+#define RX_SLOTS 2
+#endif
+
+#if PACKETBUF_SIZE - CHECKSUM_LEN < CC1110_RF_MAX_PACKET_LEN
+#define RX_MAX_LEN   (PACKETBUF_SIZE - CHECKSUM_LEN)
+#else
+#define RX_MAX_LEN   CC1110_RF_MAX_PACKET_LEN
+#endif
+
+#define RX_DMA_LEN   (1 + RX_MAX_LEN + CHECKSUM_LEN)
+#define RX_BUF_SIZE  PACKETBUF_STORAGE_SIZE
+#define RX_FRAME(i)  (rxbuf[i] + PACKETBUF_HDR_SIZE - 1) /* the length byte */
+#define RX_NEXT(i)   ((i) == RX_SLOTS - 1 ? 0 : (i) + 1)
+
+/*
+ * With the hardware address check every frame carries the receiver
+ * address byte right after the length byte
+ */
+#if CC1101_RF_CONF_ADDR_FILTER
+#define ADDR_LEN 1
+#else
+#define ADDR_LEN 0
+#endif
+
+/*
+ * Channels calibrated once at init: a hop restores the cached FSCAL values
+ * instead of running the ~720 us calibration
+ */
+#if CC1101_RF_CONF_CHANNELS
+#define CHANNELS CC1101_RF_CONF_CHANNELS
+#else
+#define CHANNELS 0
+#endif
+
+/*
+ * Per neighbor TX power: PA_TABLE0 is written before every frame with the
+ * value of the link power level of the receiver, 868 MHz values (SWRS033G)
+ */
+#if CC1101_RF_CONF_TX_POWER
+static __code const uint8_t pa_table[LINK_POWER_LEVELS] =
+{
+    0x0D, /* -20 dBm */
+    0x34, /* -10 dBm */
+    0x8F, /*  -5 dBm */
+    0x60, /*   0 dBm */
+    0xCB, /*  +7 dBm */
+};
+static uint8_t tx_pa;
+#define TX_PA_SET() (PA_TABLE0 = tx_pa)
+#else
+#define TX_PA_SET()
+#endif
+
+#if CC1101_RF_CONF_RX_LATENCY
+#define RX_LATENCY 1
+#else
+#define RX_LATENCY 0
+#endif
+
+struct rx_slot {
+    uint8_t len;
+    int8_t rssi; /* raw, in 0.5 dB steps */
+    uint8_t lqi;
+#if RX_LATENCY
+    rtimer_clock_t stamp; /* end of frame */
+#endif
+};
+
+static uint8_t rxpool[RX_SLOTS][RX_BUF_SIZE];
+static uint8_t *rxbuf[RX_SLOTS];
+static struct rx_slot rx_info[RX_SLOTS];
+static volatile uint8_t CC_AT_DATA rx_head;
+static volatile uint8_t CC_AT_DATA rx_tail;
+static volatile uint8_t CC_AT_DATA rx_count;
+static volatile uint8_t CC_AT_DATA rx_stalled; /* no free slot to arm */
+static volatile uint8_t CC_AT_DATA rx_syncs; /* sync words the channel has not ended */
+
+#if RX_LATENCY
+static rtimer_clock_t rx_latency_last;
+static rtimer_clock_t rx_latency_max;
+#endif
+
+/*
+ * Point the RX channel to the head slot and arm it. A macro and not a
+ * function because it runs from the DMA ISR too.
+ */
+#define RX_DMA_ARM() do { \
+    dma_conf[DMA_RADIO_CHANNEL].dst_h = ((uint16_t)RX_FRAME(rx_head)) >> 8; \
+    dma_conf[DMA_RADIO_CHANNEL].dst_l = (uint8_t)RX_FRAME(rx_head); \
+    DMA_ARM(DMA_RADIO_CHANNEL); \
+} while(0)
+
+/* Arm the RX channel, unless every slot holds a frame */
+#define RX_DMA_START() do { \
+    if(rx_count < RX_SLOTS) \
+    { \
+        RX_DMA_ARM(); \
+        rx_stalled = 0; \
+    } \
+    else \
+    { \
+        rx_stalled = 1; \
+    } \
+} while(0)
+
+#if ADDR_LEN
+/*---------------------------------------------------------------------------*/
+/* The radio only compares one byte: take the rime address LSB */
+void
+cc1101_rf_set_addr(const rimeaddr_t *addr)
+{
+    ADDR = addr->u8[RIMEADDR_SIZE - 1];
+}
+
+/* The address byte of the outgoing frame, 0x00 for broadcast */
+static uint8_t
+tx_addr(void)
+{
+    const rimeaddr_t *dst;
+
+    dst = packetbuf_addr(PACKETBUF_ADDR_RECEIVER);
+    if(rimeaddr_cmp(dst, &rimeaddr_null))
+    {
+        return 0x00;
+    }
+    return dst->u8[RIMEADDR_SIZE - 1];
+}
+#endif
+
+#ifdef DMA_RADIO_TX_CHANNEL
+/*
+ * The channel reads the length byte (and the address byte) from the
+ * packetbuf header area, right in front of the frame: the smallest header
+ * area must still have room for them. Checked here and not on the host:
+ * the descriptor holds 16 bit XDATA addresses and the SFR address of RFD.
+ */
+#if PACKETBUF_HDR_SIZE < 1 + ADDR_LEN
+#error "cc1101-rf: no room in the packetbuf header for the length byte"
+#endif
+#if CC1110_RF_MAX_PACKET_LEN + 1 > PACKETBUF_SIZE + PACKETBUF_HDR_SIZE
+#error "cc1101-rf: the longest frame does not fit in packetbuf"
+#endif
+/*---------------------------------------------------------------------------*/
+/*
+ * Configure the TX channel to feed RFD from buf, one byte for each radio
+ * request. buf[0] is the length byte and the frame follows it, so with
+ * DMA_VLEN_N1 the channel moves exactly buf[0] + 1 bytes.
+ */
+static void
+tx_dma_setup(uint8_t *buf)
+{
+    dma_conf[DMA_RADIO_TX_CHANNEL].src_h = ((uint16_t)buf) >> 8;
+    dma_conf[DMA_RADIO_TX_CHANNEL].src_l = (uint8_t)buf;
+
+    dma_conf[DMA_RADIO_TX_CHANNEL].dst_h = ((uint16_t)&X_RFD) >> 8;
+    dma_conf[DMA_RADIO_TX_CHANNEL].dst_l = (uint8_t)&X_RFD;
+
+    dma_conf[DMA_RADIO_TX_CHANNEL].len_h = DMA_VLEN_N1 | ((CC1110_RF_MAX_PACKET_LEN + 1) >> 8);
+    dma_conf[DMA_RADIO_TX_CHANNEL].len_l = (uint8_t)(CC1110_RF_MAX_PACKET_LEN + 1);
+    dma_conf[DMA_RADIO_TX_CHANNEL].wtt = DMA_SINGLE | DMA_T_RADIO;
+    dma_conf[DMA_RADIO_TX_CHANNEL].inc_prio = DMA_SRC_INC_1 | DMA_DST_INC_NO | DMA_PRIO_HIGH;
+}
+#endif
+
+
+/*---------------------------------------------------------------------------*/
+/* Netstack API radio driver functions */
+/*---------------------------------------------------------------------------*/
+static int
+init(void)
+{
+    uint8_t i;
+
+    PUTSTRING("RF: Init\n");
+
+    if(rf_flags & RF_ON)
+    {
+        return 0;
+    }
+
+    /**
+     * CC1101 configuration registers - Default values extracted from SmartRF Studio
+     *
+     * Configuration (the modem part is the CC1101_RF_PHY_38K4 profile, see
+     * cc1101_rf_set_phy()):
+     *
+     * Deviation = 20.629883
+     * Base frequency = 868.299866
+     * Carrier frequency = 868.299866
+     * Channel number = 0
+     * Modulated = true
+     * Modulation format = GFSK
+     * Manchester enable = false
+     * Data whitening = off
+     * Sync word qualifier mode = 30/32 sync word bits detected
+     * Preamble count = 4
+     * Channel spacing = 199.951172
+     * Carrier frequency = 867.999939
+     * Data rate = 38.3835 Kbps
+     * RX filter BW = 101.562500
+     * Data format = Normal mode
+     * Length config = Variable packet length mode. Packet length configured by the first byte after sync word
+     * CRC enable = true
+     * Packet length = 255
+     * Device address = 1
+     * Address config = Enable address check
+     * Append status = Append two status bytes to the payload of the packet. The status bytes contain RSSI and
+     * LQI values, as well as CRC OK
+     * CRC autoflush = false
+     * PA ramping = false
+     * TX power = 7
+     * Settings optimized for high sensitivity
+     */
+    PKTCTRL0  = 0x05; // packet automation control
+
+#ifdef FREQ_868MHZ
+    FREQ2     = 0x21; // frequency control word, high byte
+    FREQ1     = 0x62; // frequency control word, middle byte
+    FREQ0     = 0x76; // frequency control word, low byte
+#else
+    // Base frequency = 901.999969
+    FREQ2     = 0x22; // frequency control word, high byte
+    FREQ1     = 0xB1; // frequency control word, middle byte
+    FREQ0     = 0x3B; // frequency control word, low byte
+#endif
+    MCSM0     = 0x18; // main radio control state machine configuration
+    FSCAL3    = 0xE9; // frequency synthesizer calibration
+    FSCAL2    = 0x2A; // frequency synthesizer calibration
+    FSCAL1    = 0x00; // frequency synthesizer calibration
+    FSCAL0    = 0x1F; // frequency synthesizer calibration
+    cc1101_rf_set_phy(CC1101_RF_CONF_PHY); // modem, AGC and TEST registers
+    //PA_TABLE0 = 0xCB; // pa power setting 0: +7 dbm
+    PA_TABLE0 = 0x8F; // pa power setting 0: -5 dbm, per frame with CC1101_RF_CONF_TX_POWER
+
+
+    /* TEST1	Various Test Settings
+     Always set this register to 0x31 when being in TX. At low data rates, the
+     sensitivity can be improved by changing it to 0x35 in RX.
+     (MDMCFG2.DEM_DCFILT_OFF should be 0).
+    */
+
+    //SYNC1 = 0xD3; /* Sync Word, High Byte */
+    //SYNC0 = 0x91; /* Sync Word, Low Byte */
+
+    /* networks with a different sync word do not even see each other */
+    SYNC1 = CC1101_RF_CONF_SYNC >> 8; /* Sync Word, High Byte */
+    SYNC0 = CC1101_RF_CONF_SYNC & 0xFF; /* Sync Word, Low Byte */
+    PKTLEN = RX_MAX_LEN; /* Packet Length */
+
+
+    /* The reset default value
+     * Packet Automation Control: PQT == 0 => sync word always accepted
+     * APPEND_STATUS = 1
+     * no hw address check
+     */
+    //PKTCTRL1 = 0x04;
+
+#if ADDR_LEN
+    /* APPEND_STATUS = 1
+     * ADR_CHK = 11: address check, 0x00 and 0xFF broadcast
+     */
+    PKTCTRL1 = 0x07;
+    cc1101_rf_set_addr(&rimeaddr_node_addr);
+#endif
+
+    /* MCSM2	Main Radio Control State Machine Configuration
+
+       UNUSED RX_TIME_RSSI RX_TIME_QUAL RX_TIME[2:0]
+         000     0              0          111
+
+       RX_TIME[2:0] Timeout for sync word search in RX. The timeout is relative to the
+                    programmed tEvent0.
+                    111: Until end of packet
+    */
+    //MCSM2 = 0x07; // the default value
+
+    /* MCSM1	Main Radio Control State Machine Configuration
+
+       UNUSED CCA_MODE RXOFF_MODE TXOFF_MODE
+         00     11         11          00
+
+        CCA_MODE[1:0] Selects CCA_MODE; Reflected in CCA signal
+                      11: If RSSI below threshold unless currently receiving a packet
+
+        RXOFF_MODE[1:0] Select what should happen (next state) when a packet has been received
+                        11: Stay in RX
+
+        TXOFF_MODE[1:0] Select what should happen (next state) when a packet has been sent (TX)
+                        11: RX
+    */
+    MCSM1 = 0x3F;
+
+    /* MCSM0	Main Radio Control State Machine Configuration
+
+       UNUSED  FS_AUTOCAL[1:0]  RESERVD  CLOSE_IN_RX[1:0]
+         00      11             10        00
+
+       FS_AUTOCAL=11 Calibration mode: Every 4th time when going from RX or TX to IDLE automatically
+    */
+    //MCSM0 = 0x38; // calibrate Every 4th time when going from RX or TX to IDLE automatically
+
+#if CHANNELS
+    // FS_AUTOCAL=00: never calibrate, the FSCAL values come from the cache
+    MCSM0 = 0x08;
+    cc1101_rf_calibrate();
+    cc1101_rf_set_channel(CC1101_RF_CONF_CHANNEL);
+#endif
+
+
+    /*
+     * GDO0_CFG[5:0] : 001001 CCA high when RSSI level is below threshold on P1_5
+     */
+    //IOCFG0 = 0x09;
+
+    /*
+    configure the channel for RADIO
+    */
+    dma_conf[DMA_RADIO_CHANNEL].src_h = 0xDF;  //SFRX(X_RFD, 0xDFD9);
+    dma_conf[DMA_RADIO_CHANNEL].src_l = 0xD9;
+
+    for(i = 0; i < RX_SLOTS; i++)
+    {
+        rxbuf[i] = rxpool[i];
+    }
+    rx_head = 0;
+    rx_tail = 0;
+    rx_count = 0;
+    dma_conf[DMA_RADIO_CHANNEL].dst_h = ((uint16_t)RX_FRAME(rx_head))>>8;
+    dma_conf[DMA_RADIO_CHANNEL].dst_l = (uint8_t)RX_FRAME(rx_head);
+
+    // length byte + frame + 2 status bytes, never more than a slot
+    dma_conf[DMA_RADIO_CHANNEL].len_h = DMA_VLEN_N3 | (RX_DMA_LEN >> 8);
+    dma_conf[DMA_RADIO_CHANNEL].len_l = (uint8_t)RX_DMA_LEN;
+    dma_conf[DMA_RADIO_CHANNEL].wtt = DMA_SINGLE | DMA_T_RADIO;
+    dma_conf[DMA_RADIO_CHANNEL].inc_prio = DMA_DST_INC_1 | DMA_IRQ_MASK_ENABLE | DMA_PRIO_HIGH;
+
+    // enable DMA interrupt
+    IEN1 |= DMAIE;
+
+    // the DMA ISR polls the RX process when a frame is queued
+    process_start(&cc1101_rf_process, NULL);
+    dma_associate_process(&cc1101_rf_process, DMA_RADIO_CHANNEL);
+
+    RF_TX_LED_OFF();
+    RF_RX_LED_OFF();
+
+    // enable RFIF interrupt: RX overflows, sync words to realign the RX
+    // channel, and IRQ_DONE ends a transmission
+#ifdef DMA_RADIO_TX_CHANNEL
+    RFIM = IM_RXOVF | IM_SFD | IM_DONE;
+#else
+    RFIM = IM_RXOVF | IM_SFD;
+#endif
+    IEN2 |= IEN2_RFIE;
+
+    rf_flags |= RF_ON;
+
+    PUTSTRING("RF: Init DONE\n");
+
+    return 1;
+}
+
+/*
+ prepare not needed for this driver
+*/
+static int
+prepare(const void *payload, unsigned short payload_len)
+{
+    payload;
+    payload_len;
+    return 0;
+}
+
+#ifdef DMA_RADIO_TX_CHANNEL
+/*---------------------------------------------------------------------------*/
+/*
+ * Called when the frame is out or could not be sent, from the RF ISR,
+ * the rtimer ISR or transmit(). Puts the radio back as it was before
+ * transmit() and reports the outcome.
+ */
+static void
+tx_finish(uint8_t status)
+{
+    uint8_t on_air;
+
+    on_air = (tx_state == TX_ON_AIR);
+    tx_state = TX_IDLE;
+
+    if(on_air)
+    {
+        ENERGEST_OFF(ENERGEST_TYPE_TRANSMIT);
+        ENERGEST_ON(ENERGEST_TYPE_LISTEN);
+        RIMESTATS_ADD(lltx);
+        RF_TX_LED_OFF();
+    }
+
+#if TX_ASYNC
+    if(on_air)
+    {
+        tx_count++;
+
+        /*
+         * Repeated frame: the next copy goes out from here, so two copies
+         * are apart by the RX to TX turnaround, not by a process latency
+         */
+        if(tx_repeat && RTIMER_CLOCK_LT(RTIMER_NOW(), tx_repeat_end))
+        {
+            tx_on_air();
+            return;
+        }
+    }
+    tx_repeat = 0;
+#endif
+
+    if(rf_flags & WAS_OFF)
+    {
+        rf_flags &= ~WAS_OFF;
+        off();
+    }
+    else if(on_air)
+    {
+        // TXOFF_MODE brought the radio back in RX: enable DMA channel 0
+        rx_syncs = 0;
+        RX_DMA_START();
+    }
+
+    tx_status = status;
+#if TX_ASYNC
+    tx_done = 1;
+    process_poll(&cc1101_rf_process);
+#endif
+}
+
+/* The radio is in RX: check the channel and start the frame */
+static void
+tx_start(void)
+{
+    if(channel_clear() == CC1110_RF_CCA_BUSY)
+    {
+        if(tx_tries < LBT_RETRIES)
+        {
+            // back off and look again, the radio stays in RX meanwhile
+            RIMESTATS_ADD(lbtretry);
+            tx_state = TX_SETTLING;
+            rtimer_set(&tx_rtimer, RTIMER_NOW() + LBT_DELAY(tx_tries), 1,
+                       tx_settled, NULL);
+            tx_tries++;
+            return;
+        }
+        RIMESTATS_ADD(contentiondrop);
+        tx_finish(RADIO_TX_COLLISION);
+        return;
+    }
+
+#if TX_ASYNC
+    tx_repeat_end = RTIMER_NOW() + tx_repeat;
+#endif
+    tx_on_air();
+}
+
+/* Strobe STX, the DMA feeds RFD and the RF ISR sees the end of the frame */
+static void
+tx_on_air(void)
+{
+    // disable DMA channel 0 (RX)
+    DMA_ABORT(DMA_RADIO_CHANNEL);
+
+    tx_dma_setup(txptr);
+    DMA_ARM(DMA_RADIO_TX_CHANNEL);
+
+    /* Start the transmission */
+    RF_TX_LED_ON();
+    ENERGEST_OFF(ENERGEST_TYPE_LISTEN);
+    ENERGEST_ON(ENERGEST_TYPE_TRANSMIT);
+
+    tx_state = TX_ON_AIR;
+    TX_PA_SET();
+    RFIF &= ~IRQ_DONE;
+    RFST = STX;
+}
+
+/* ONOFF_TIME or the LBT backoff has elapsed */
+static void
+tx_settled(struct rtimer *t, void *ptr)
+{
+    tx_start();
+}
+
+/* Send the frame at txptr, turning the radio on first if needed */
+static void
+tx_begin(void)
+{
+    tx_tries = 0;
+
+    if(!(rf_flags & RX_ACTIVE))
+    {
+        on();
+        rf_flags |= WAS_OFF;
+        tx_state = TX_SETTLING;
+        rtimer_set(&tx_rtimer, RTIMER_NOW() + ONOFF_TIME, 1, tx_settled, NULL);
+    }
+    else
+    {
+        tx_start();
+    }
+}
+
+/*
+ * Keep the CPU idle till the frame is out. An IRQ raised after the check
+ * is served right after PCON is written, so it wakes us up instead of
+ * being lost.
+ */
+static void
+tx_wait(void)
+{
+    DISABLE_INTERRUPTS();
+    while(tx_state != TX_IDLE)
+    {
+        ENABLE_INTERRUPTS();
+        PCON |= PCON_IDLE;
+        ASM(nop);
+        DISABLE_INTERRUPTS();
+    }
+    ENABLE_INTERRUPTS();
+}
+
+/*
+ * Nothing busy waits here: when the radio is off it is turned on and an
+ * rtimer starts the frame once it has settled, then the DMA feeds RFD and
+ * the RF ISR catches IRQ_DONE.
+ * With CC1101_RF_CONF_TX_ASYNC and a callback set with
+ * cc1101_rf_set_tx_callback() we return RADIO_TX_OK as soon as the frame
+ * is queued and the real outcome goes to the callback. Otherwise the CPU
+ * idles till the end and the outcome is returned.
+ */
+static int
+transmit(unsigned short transmit_len)
+{
+    PRINTF("TX: %d\n", rf_flags);
+
+    if(tx_state != TX_IDLE || transmit_len > CC1110_RF_MAX_PACKET_LEN - ADDR_LEN)
+    {
+#if TX_ASYNC
+        tx_repeat = 0;
+#endif
+        return RADIO_TX_ERR;
+    }
+
+    /* SWRS033G
+     * The packet length is defined as the
+    * payload data, excluding the length byte and
+    * the optional CRC
+    */
+#if TX_ASYNC
+    // packetbuf may be reused before the frame is on air: take a copy
+    dma_memcpy(txbuf + 1 + ADDR_LEN, packetbuf_hdrptr(), transmit_len);
+    txptr = txbuf;
+#else
+    // the length byte must sit right in front of the frame
+    if(!packetbuf_hdralloc(1 + ADDR_LEN))
+    {
+        PUTSTRING("RF: no room for the length byte\n");
+        return RADIO_TX_ERR;
+    }
+    txptr = packetbuf_hdrptr();
+#endif
+    txptr[0] = transmit_len + ADDR_LEN;
+#if ADDR_LEN
+    txptr[1] = tx_addr();
+#endif
+#if CC1101_RF_CONF_TX_POWER
+    tx_pa = pa_table[link_power_level(packetbuf_addr(PACKETBUF_ADDR_RECEIVER))];
+#endif
+
+#if TX_ASYNC
+    tx_count = 0;
+#endif
+    tx_begin();
+
+#if TX_ASYNC
+    if(tx_callback != NULL)
+    {
+        return RADIO_TX_OK;
+    }
+    tx_wait();
+#else
+    tx_wait();
+    packetbuf_hdr_remove(1 + ADDR_LEN);
+#endif
+
+    /* OK, sent. We are now ready to send more */
+    return tx_status;
+}
+#else
+static volatile uint8_t lbt_wait;
+static struct rtimer lbt_rtimer;
+
+static void
+lbt_wake(struct rtimer *t, void *ptr)
+{
+    lbt_wait = 0;
+}
+
+/*
+ * Without the DMA channel the CPU feeds RFD byte after byte, so this
+ * path busy waits for the radio. The LBT backoffs idle the CPU.
+ */
+static int
+transmit(unsigned short transmit_len)
+{
+    uint8_t counter;
+    uint8_t tries;
+    rtimer_clock_t t0;
+    uint8_t *dataptr;
+
+    PRINTF("TX: %d\n", rf_flags);
+
+    if(!(rf_flags & RX_ACTIVE))
+    {
+        t0 = RTIMER_NOW();
+        on();
+        rf_flags |= WAS_OFF;
+        while(RTIMER_CLOCK_LT(RTIMER_NOW(), t0 + ONOFF_TIME));
+    }
+
+    for(tries = 0; channel_clear() == CC1110_RF_CCA_BUSY; tries++)
+    {
+        if(tries == LBT_RETRIES)
+        {
+            RIMESTATS_ADD(contentiondrop);
+            if(rf_flags & WAS_OFF)
+            {
+                rf_flags &= ~WAS_OFF;
+                off();
+            }
+            return RADIO_TX_COLLISION;
+        }
+
+        RIMESTATS_ADD(lbtretry);
+        lbt_wait = 1;
+        rtimer_set(&lbt_rtimer, RTIMER_NOW() + LBT_DELAY(tries), 1, lbt_wake, NULL);
+
+        DISABLE_INTERRUPTS();
+        while(lbt_wait)
+        {
+            ENABLE_INTERRUPTS();
+            PCON |= PCON_IDLE;
+            ASM(nop);
+            DISABLE_INTERRUPTS();
+        }
+        ENABLE_INTERRUPTS();
+    }
+
+    // disable the RX DMA channel
+    DMA_ABORT(DMA_RADIO_CHANNEL);
+
+    // send the packet
+    dataptr = packetbuf_hdrptr();
+
+    /* Start the transmission */
+    RF_TX_LED_ON();
+    ENERGEST_OFF(ENERGEST_TYPE_LISTEN);
+    ENERGEST_ON(ENERGEST_TYPE_TRANSMIT);
+
+#if CC1101_RF_CONF_TX_POWER
+    tx_pa = pa_table[link_power_level(packetbuf_addr(PACKETBUF_ADDR_RECEIVER))];
+#endif
+    TX_PA_SET();
+    RFIF &= ~IRQ_DONE;
+    RFST = STX;
+
+    while(MARCSTATE != TX_STATE) {}
+
+    PRINTF("mcs: %2X, len:%d, RF:%d\n", MARCSTATE, transmit_len, RFIF);
+
+    // Print the crystal status
+    PRINTF("dptr: %4X\n", dataptr);
+
+    for(counter=0; counter<transmit_len; counter++)
+    {
+        PRINTF("[%d]", dataptr[counter]);
+    }
+    while(!RFTXRXIF);
+    RFTXRXIF = 0;
+    RFD = transmit_len + ADDR_LEN;
+#if ADDR_LEN
+    while(!RFTXRXIF);
+    RFTXRXIF = 0;
+    RFD = tx_addr();
+#endif
+    for(counter=0; counter<transmit_len; counter++)
+    {
+        while(!RFTXRXIF); // wait radio to be TX ready
+        RFTXRXIF = 0;
+        RFD = dataptr[counter];
+
+    }
+    while (!(RFIF & IRQ_DONE)) {}
+
+    PRINTF("\nTX OK:%d\n", RFIF);
+
+    ENERGEST_OFF(ENERGEST_TYPE_TRANSMIT);
+    ENERGEST_ON(ENERGEST_TYPE_LISTEN);
+
+    if(rf_flags & WAS_OFF)
+    {
+        rf_flags &= ~WAS_OFF;
+        off();
+    }
+    else
+    {
+        // enable DMA channel 0 (RX)
+        rx_syncs = 0;
+        RX_DMA_START();
+    }
+
+    RIMESTATS_ADD(lltx);
+
+    RF_TX_LED_OFF();
+
+    /* OK, sent. We are now ready to send more */
+    return RADIO_TX_OK;
+}
+#endif
+
+/*---------------------------------------------------------------------------*/
+static int
+send(void *payload, unsigned short payload_len)
+{
+    //prepare(payload, payload_len);
+    return transmit(payload_len);
+}
+
+/*
+ * Set the link attributes of the tail slot. The appended RSSI byte
+ * counts 0.5 dB steps.
+ */
+static void
+rx_set_attr(void)
+{
+    packetbuf_set_attr(PACKETBUF_ATTR_RSSI, rx_info[rx_tail].rssi / 2 - RSSI_OFFSET);
+    packetbuf_set_attr(PACKETBUF_ATTR_LINK_QUALITY, rx_info[rx_tail].lqi);
+    RIMESTATS_ADD(llrx);
+
+#if RX_LATENCY
+    rx_latency_last = RTIMER_NOW() - rx_info[rx_tail].stamp;
+    if(rx_latency_last > rx_latency_max)
+    {
+        rx_latency_max = rx_latency_last;
+    }
+#endif
+}
+
+/*
+ * Back to the sync word search with the RX channel armed. The radio has
+ * overflowed or may be in the middle of a frame the channel did not see.
+ */
+static void
+rx_restart(void)
+{
+    DMA_ABORT(DMA_RADIO_CHANNEL);
+    RFST = SIDLE;
+    while(MARCSTATE != IDLE_STATE);
+    RFST = SRX;
+    rx_syncs = 0;
+    RX_DMA_START();
+}
+
+/*
+ * Give the tail slot back to the DMA ISR and arm the channel if it was
+ * waiting. A radio still looking for a sync word takes the next frame as
+ * it is; one that overflowed, or is in a frame that started while no slot
+ * was free, goes back to the sync search first.
+ */
+static void
+rx_release(void)
+{
+    DISABLE_INTERRUPTS();
+    rx_tail = RX_NEXT(rx_tail);
+    rx_count--;
+#ifdef DMA_RADIO_TX_CHANNEL
+    // a frame on air brings RX back itself, see tx_finish()
+    if(rx_stalled && (rf_flags & RX_ACTIVE) && tx_state != TX_ON_AIR)
+#else
+    if(rx_stalled && (rf_flags & RX_ACTIVE))
+#endif
+    {
+        if(MARCSTATE != RX_STATE || (PKTSTATUS & PKTSTATUS_SFD))
+        {
+            rx_restart();
+        }
+        else
+        {
+            rx_syncs = 0;
+            RX_DMA_START();
+        }
+    }
+    ENABLE_INTERRUPTS();
+}
+
+/*
+ * Read the oldest received frame from the RX ring and release its slot.
+ */
+static int
+read(void *buf, unsigned short bufsize)
+{
+    uint8_t pktlen;
+
+    if(rx_count == 0)
+    {
+        return 0;
+    }
+
+    pktlen = rx_info[rx_tail].len - ADDR_LEN;
+    if(pktlen > bufsize)
+    {
+        RIMESTATS_ADD(toolong);
+        pktlen = 0;
+    }
+    else
+    {
+        memcpy(buf, RX_FRAME(rx_tail) + 1 + ADDR_LEN, pktlen);
+        rx_set_attr();
+    }
+
+    rx_release();
+
+    return pktlen;
+}
+
+/*
+ * Zero-copy read: the slot holding the oldest frame becomes the packetbuf
+ * storage and the old packetbuf storage takes its place in the ring.
+ */
+int
+cc1101_rf_read_packetbuf(void)
+{
+    uint8_t pktlen;
+
+    if(rx_count == 0)
+    {
+        return 0;
+    }
+
+    pktlen = rx_info[rx_tail].len;
+    rxbuf[rx_tail] = packetbuf_swap(rxbuf[rx_tail]);
+    packetbuf_set_datalen(pktlen);
+#if ADDR_LEN
+    // the address byte has been checked by the radio
+    packetbuf_hdrreduce(ADDR_LEN);
+    pktlen -= ADDR_LEN;
+#endif
+    rx_set_attr();
+
+    rx_release();
+
+    return pktlen;
+}
+
+#if 0
+static int
+read(void *buf, unsigned short bufsize)
+{
+    uint8_t i;
+    uint8_t len;
+    uint8_t crc_corr;
+    int8_t rssi;
+
+    PUTSTRING("RF: Read\n");
+
+    /* Check the length */
+    while(!RFTXRXIF); // wait packet ready
+    len = RFD;
+
+    /* Check for validity */
+    if(len > CC1110_RF_MAX_PACKET_LEN)
+    {
+        /* if here, the best assumption is that we must be out of sync. */
+        PUTSTRING("RF: bad sync\n");
+
+        RIMESTATS_ADD(badsynch);
+        //CC2530_CSP_ISFLUSHRX();
+        return 0;
+    }
+
+    if(len <= CC1110_RF_MIN_PACKET_LEN)
+    {
+        PUTSTRING("RF: too short\n");
+
+        RIMESTATS_ADD(tooshort);
+        //CC2530_CSP_ISFLUSHRX();
+        return 0;
+    }
+
+    if(len - CHECKSUM_LEN > bufsize)
+    {
+        PUTSTRING("RF: too long\n");
+
+        RIMESTATS_ADD(toolong);
+        //CC2530_CSP_ISFLUSHRX();
+        return 0;
+    }
+
+#if CC1110_RF_CONF_HEXDUMP
+    /* If we reach here, chances are the FIFO is holding a valid frame */
+    io_arch_writeb(magic[0]);
+    io_arch_writeb(magic[1]);
+    io_arch_writeb(magic[2]);
+    io_arch_writeb(magic[3]);
+    io_arch_writeb(len);
+#endif
+
+    RF_RX_LED_ON();
+
+    PUTSTRING("RF: read (0x");
+    PUTHEX(len);
+    PUTSTRING(" bytes) = ");
+    len -= CHECKSUM_LEN;
+    for(i = 0; i < len; ++i)
+    {
+        while(!RFTXRXIF); // wait byte packet ready to read
+        ((unsigned char *)(buf))[i] = RFD;
+#if CC1110_RF_CONF_HEXDUMP
+        io_arch_writeb(((unsigned char *)(buf))[i]);
+#endif
+        PUTHEX(((unsigned char *)(buf))[i]);
+    }
+    PUTSTRING("\n");
+
+    /* Read the RSSI and CRC/Corr bytes */
+    while(!RFTXRXIF); // wait packet ready
+    rssi = ((int8_t) RFD) - RSSI_OFFSET;
+    while(!RFTXRXIF); // wait packet ready
+    crc_corr = RFD;
+
+#if CC1110_RF_CONF_HEXDUMP
+    io_arch_writeb(rssi);
+    io_arch_writeb(crc_corr);
+    io_arch_flush();
+#endif
+
+    /* MS bit CRC OK/Not OK, 7 LS Bits, Correlation value */
+    if(crc_corr & CRC_BIT_MASK)
+    {
+        packetbuf_set_attr(PACKETBUF_ATTR_RSSI, rssi);
+        packetbuf_set_attr(PACKETBUF_ATTR_LINK_QUALITY, crc_corr & LQI_BIT_MASK);
+        RIMESTATS_ADD(llrx);
+    }
+    else
+    {
+        RIMESTATS_ADD(badcrc);
+        //CC2530_CSP_ISFLUSHRX();
+        RF_RX_LED_OFF();
+        return 0;
+    }
+
+    RF_RX_LED_OFF();
+
+    return (len);
+}
+#endif
+
+/*---------------------------------------------------------------------------*/
+static int
+channel_clear(void)
+{
+#if 0
+    if(P1_5)
+    {
+        return CC1110_RF_CCA_CLEAR;
+    }
+    return CC1110_RF_CCA_BUSY;
+#endif
+    return (PKTSTATUS & PKTSTATUS_CCA);
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+receiving_packet(void)
+{
+    PUTSTRING("RF: Receiving\n");
+
+    /*
+     * SFD high while transmitting and receiving.
+     * TX_ACTIVE high only when transmitting
+     *
+     * FSMSTAT1 & (TX_ACTIVE | SFD) == SFD <=> receiving
+     */
+    return (PKTSTATUS & PKTSTATUS_SFD);
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+pending_packet(void)
+{
+    return rx_count;
+}
+
+/*---------------------------------------------------------------------------*/
+static int on(void)
+{
+    PUTSTRING("RF: switching RADIO on\n");
+
+    if (!(rf_flags & RX_ACTIVE))
+    {
+        PRINTF("mcst-on-0: %X\n", MARCSTATE);
+        switch (MARCSTATE)
+        {
+        case IDLE_STATE:
+            RFST = SRX;
+            break;
+        case RX_STATE:
+            break;
+        default:
+            /* if in an unexpected state reset the radio
+               and go to RX
+            */
+            RFST = SIDLE;
+            while(MARCSTATE!=IDLE_STATE);
+            RFST = SRX;
+        }
+
+        // wait RX state
+        //while(MARCSTATE!=RX_STATE);
+
+        // ARM the DMA radio channel
+        rx_syncs = 0;
+        RX_DMA_START();
+
+        rf_flags |= RX_ACTIVE;
+    }
+
+    PRINTF("mcst-on-1: %X\n", MARCSTATE);
+    ENERGEST_ON(ENERGEST_TYPE_LISTEN);
+    return 1;
+}
+
+/*
+ * Radio is switched off
+ */
+static int
+off(void)
+{
+#ifdef DMA_RADIO_TX_CHANNEL
+    if(tx_state != TX_IDLE)
+    {
+        // a frame is on its way: switch off when it is done
+        rf_flags |= WAS_OFF;
+        return 1;
+    }
+#endif
+
+    RFST = SIDLE;
+    rf_flags &= ~RX_ACTIVE;
+
+    // Abort the DMA radio channel
+    DMA_ABORT(DMA_RADIO_CHANNEL);
+
+    ENERGEST_OFF(ENERGEST_TYPE_LISTEN);
+    return 1;
+}
+
+/*
+ * For what I understand from the data sheet this is invoked if and only if
+ * a complete packet is received. The frame is queued if its CRC is good,
+ * otherwise it is dropped, and the channel is re-armed at once on the next
+ * free slot so back-to-back frames are not lost while the main loop is busy.
+ */
+void rf_dma_callback_isr(void)
+{
+    if(rx_syncs)
+    {
+        rx_syncs--;
+    }
+
+    rx_info[rx_head].len = RX_FRAME(rx_head)[0];
+
+    if(rx_info[rx_head].len > RX_MAX_LEN)
+    {
+        RIMESTATS_ADD(toolong);
+    }
+    else if(rx_info[rx_head].len <= ADDR_LEN)
+    {
+        RIMESTATS_ADD(tooshort);
+    }
+    else if(!(RX_FRAME(rx_head)[rx_info[rx_head].len + 2] & CRC_BIT_MASK))
+    {
+        RIMESTATS_ADD(badcrc);
+    }
+    else
+    {
+        /* MS bit CRC OK/Not OK, 7 LS Bits, Correlation value */
+        rx_info[rx_head].rssi = RX_FRAME(rx_head)[rx_info[rx_head].len + 1];
+        rx_info[rx_head].lqi = RX_FRAME(rx_head)[rx_info[rx_head].len + 2] & LQI_BIT_MASK;
+#if RX_LATENCY
+        rx_info[rx_head].stamp = RTIMER_NOW();
+#endif
+        rx_head = RX_NEXT(rx_head);
+        rx_count++;
+    }
+
+    if(rf_flags & RX_ACTIVE)
+    {
+        RX_DMA_START();
+    }
+}
+
+/* avoid referencing bits since we're not using them */
+#pragma save
+#if CC_CONF_OPTIMIZE_STACK_SIZE
+#pragma exclude bits
+#endif
+void
+rfif_isr(void) __interrupt(RF_VECTOR)
+{
+    ENERGEST_ON(ENERGEST_TYPE_IRQ);
+
+    // clear the CPU flags (S1CON.RFIF_1, S1CON.RFIF_0)
+    S1CON &= ~0x03;
+
+    /*
+     * A received byte nobody took: the ring is full (rx_release() restarts
+     * the radio, keep it in IDLE meanwhile) or the channel was late
+     */
+    if(RFIF & IRQ_RXOVF)
+    {
+        RFIF &= ~IRQ_RXOVF;
+        RIMESTATS_ADD(rxdrop);
+        if(rx_stalled)
+        {
+            RFST = SIDLE;
+        }
+        else
+        {
+            rx_restart();
+        }
+    }
+
+    /*
+     * A sync word in RX. The radio drops a frame half way through when the
+     * address byte does not match or the length is above PKTLEN, and goes
+     * back to the sync search without telling the RX channel, which would
+     * then take the next frame from the middle. If the channel has not
+     * ended since the previous sync word (and is not just waiting for the
+     * DMA ISR), that frame was dropped: restart the channel on this one.
+     * The new channel must be armed before the length byte arrives, one
+     * byte time after the sync word; when this ISR is later than that the
+     * frame fails the length or CRC check and the next sync word realigns.
+     */
+    if(RFIF & IRQ_SFD)
+    {
+        RFIF &= ~IRQ_SFD;
+        if(MARCSTATE == RX_STATE && !rx_stalled)
+        {
+            if(rx_syncs && !(DMAIRQ & (1 << DMA_RADIO_CHANNEL)))
+            {
+                RIMESTATS_ADD(badsynch);
+                DMA_ABORT(DMA_RADIO_CHANNEL);
+                RX_DMA_ARM();
+                rx_syncs = 0;
+            }
+            rx_syncs++;
+        }
+    }
+
+#ifdef DMA_RADIO_TX_CHANNEL
+    if(RFIF & IRQ_DONE)
+    {
+        RFIF &= ~IRQ_DONE;
+
+        // IRQ_DONE also ends every received frame, the DMA ISR takes those
+        if(tx_state == TX_ON_AIR)
+        {
+            tx_finish(RADIO_TX_OK);
+        }
+    }
+#endif
+
+    ENERGEST_OFF(ENERGEST_TYPE_IRQ);
+}
+#pragma restore
+
+/*---------------------------------------------------------------------------*/
+/*
+ * PHY profiles, SmartRF Studio values for a 26 MHz crystal. Every profile
+ * keeps GFSK (MSK at 500k) with a 30/32 sync word qualifier.
+ */
+struct phy_profile {
+    uint8_t fsctrl1;  /* IF frequency */
+    uint8_t mdmcfg4;  /* RX filter BW, data rate exponent */
+    uint8_t mdmcfg3;  /* data rate mantissa */
+    uint8_t mdmcfg2;  /* modulation, sync mode */
+    uint8_t deviatn;
+    uint8_t foccfg;
+    uint8_t bscfg;
+    uint8_t agcctrl2;
+    uint8_t agcctrl1;
+    uint8_t agcctrl0;
+    uint8_t frend1;
+    uint8_t test2;
+    uint8_t test1;
+    uint8_t test0;
+};
+
+static __code const struct phy_profile phy_profiles[CC1101_RF_PHY_COUNT] =
+{
+    /* 1.2 kbps, dev 5.2 kHz, BW 58 kHz: long range */
+    { 0x06, 0xF5, 0x83, 0x13, 0x15, 0x16, 0x6C, 0x03, 0x40, 0x91, 0x56, 0x81, 0x35, 0x09 },
+    /* 38.4 kbps, dev 20.6 kHz, BW 101 kHz */
+    { 0x06, 0xCA, 0x83, 0x13, 0x35, 0x16, 0x6C, 0x43, 0x40, 0x91, 0x56, 0x88, 0x31, 0x09 },
+    /* 100 kbps, dev 47.6 kHz, BW 203 kHz */
+    { 0x08, 0x8B, 0xF8, 0x13, 0x47, 0x1D, 0x1C, 0xC7, 0x00, 0xB2, 0xB6, 0x88, 0x31, 0x09 },
+    /* 250 kbps, dev 127 kHz, BW 541 kHz */
+    { 0x0C, 0x2D, 0x3B, 0x13, 0x62, 0x1D, 0x1C, 0xC7, 0x00, 0xB0, 0xB6, 0x88, 0x31, 0x09 },
+    /* 500 kbps MSK, BW 812 kHz */
+    { 0x0E, 0x0E, 0x3B, 0x73, 0x00, 0x1D, 0x1C, 0xC7, 0x00, 0xB0, 0xB6, 0x88, 0x31, 0x09 },
+};
+
+static uint8_t phy = CC1101_RF_CONF_PHY;
+/*---------------------------------------------------------------------------*/
+int
+cc1101_rf_set_phy(uint8_t profile)
+{
+    __code const struct phy_profile *p;
+    uint8_t was_on;
+
+    if(profile >= CC1101_RF_PHY_COUNT)
+    {
+        return 0;
+    }
+
+#ifdef DMA_RADIO_TX_CHANNEL
+    if(tx_state != TX_IDLE)
+    {
+        return 0;
+    }
+#endif
+
+    // the modem registers are written in IDLE
+    was_on = rf_flags & RX_ACTIVE;
+    if(was_on)
+    {
+        off();
+        while(MARCSTATE != IDLE_STATE);
+    }
+
+    phy = profile;
+    p = &phy_profiles[profile];
+
+    FSCTRL1   = p->fsctrl1;
+    MDMCFG4   = p->mdmcfg4;
+    MDMCFG3   = p->mdmcfg3;
+    MDMCFG2   = p->mdmcfg2;
+    DEVIATN   = p->deviatn;
+    FOCCFG    = p->foccfg;
+    BSCFG     = p->bscfg;
+    AGCCTRL2  = p->agcctrl2;
+    AGCCTRL1  = p->agcctrl1;
+    AGCCTRL0  = p->agcctrl0;
+    FREND1    = p->frend1;
+    cc1101_rf_restore();
+
+    if(was_on)
+    {
+        on();
+    }
+
+    return 1;
+}
+/*---------------------------------------------------------------------------*/
+uint8_t
+cc1101_rf_get_phy(void)
+{
+    return phy;
+}
+#if CHANNELS
+/*---------------------------------------------------------------------------*/
+/* FSCAL3, FSCAL2, FSCAL1 of every channel */
+static __xdata uint8_t fscal[CHANNELS][3];
+static uint8_t channel;
+/*---------------------------------------------------------------------------*/
+void
+cc1101_rf_calibrate(void)
+{
+    uint8_t was_on;
+    uint8_t ch;
+
+    was_on = rf_flags & RX_ACTIVE;
+    if(was_on)
+    {
+        off();
+    }
+    RFST = SIDLE;
+    while(MARCSTATE != IDLE_STATE);
+
+    for(ch = 0; ch < CHANNELS; ch++)
+    {
+        CHANNR = ch;
+        RFST = SCAL;
+        // the strobe takes a few cycles to leave IDLE (MANCAL), then
+        // ~720 us to come back: wait for both, not just for IDLE
+        while(MARCSTATE == IDLE_STATE);
+        while(MARCSTATE != IDLE_STATE);
+
+        fscal[ch][0] = FSCAL3;
+        fscal[ch][1] = FSCAL2;
+        fscal[ch][2] = FSCAL1;
+    }
+
+    // back on the current channel
+    CHANNR = channel;
+    FSCAL3 = fscal[channel][0];
+    FSCAL2 = fscal[channel][1];
+    FSCAL1 = fscal[channel][2];
+
+    if(was_on)
+    {
+        on();
+    }
+}
+/*---------------------------------------------------------------------------*/
+int
+cc1101_rf_set_channel(uint8_t ch)
+{
+    uint8_t was_on;
+
+    if(ch >= CHANNELS)
+    {
+        return 0;
+    }
+
+#ifdef DMA_RADIO_TX_CHANNEL
+    if(tx_state != TX_IDLE)
+    {
+        return 0;
+    }
+#endif
+
+    // the synthesizer is only reprogrammed in IDLE
+    was_on = rf_flags & RX_ACTIVE;
+    if(was_on)
+    {
+        off();
+        while(MARCSTATE != IDLE_STATE);
+    }
+
+    channel = ch;
+    CHANNR = ch;
+    FSCAL3 = fscal[ch][0];
+    FSCAL2 = fscal[ch][1];
+    FSCAL1 = fscal[ch][2];
+
+    if(was_on)
+    {
+        on();
+    }
+
+    return 1;
+}
+/*---------------------------------------------------------------------------*/
+uint8_t
+cc1101_rf_get_channel(void)
+{
+    return channel;
+}
+#endif
+/*---------------------------------------------------------------------------*/
+/*
+ * The TEST registers are not retained in PM2 (SWRS033G), write them again
+ * before the radio is used
+ */
+void
+cc1101_rf_restore(void)
+{
+    TEST2     = phy_profiles[phy].test2; // various test settings
+    TEST1     = phy_profiles[phy].test1; // various test settings
+    TEST0     = phy_profiles[phy].test0; // various test settings
+}
+/*---------------------------------------------------------------------------*/
+/*
+ * The LSB of the RSSI in RX is thermal noise: take one every two rtimer
+ * ticks, so the AGC has updated it between two samples
+ */
+uint16_t
+cc1101_rf_noise(void)
+{
+    uint16_t noise;
+    uint8_t was_on;
+    uint8_t i;
+    rtimer_clock_t t0;
+
+    was_on = rf_flags & RX_ACTIVE;
+    if(!was_on)
+    {
+        on();
+    }
+
+    noise = 0;
+    t0 = RTIMER_NOW() + ONOFF_TIME;
+    for(i = 0; i < 16; i++)
+    {
+        while(RTIMER_CLOCK_LT(RTIMER_NOW(), t0));
+        noise = (noise << 1) | (RSSI & 0x01);
+        t0 += 2;
+    }
+
+    if(!was_on)
+    {
+        off();
+    }
+    return noise;
+}
+
+#if TX_ASYNC
+/*---------------------------------------------------------------------------*/
+void
+cc1101_rf_set_tx_callback(cc1101_rf_tx_callback_t callback)
+{
+    tx_callback = callback;
+}
+/*---------------------------------------------------------------------------*/
+void
+cc1101_rf_set_repeat(rtimer_clock_t duration)
+{
+    tx_repeat = duration;
+}
+/*---------------------------------------------------------------------------*/
+uint8_t
+cc1101_rf_tx_count(void)
+{
+    return tx_count;
+}
+#endif
+
+#if RX_LATENCY
+/*---------------------------------------------------------------------------*/
+void
+cc1101_rf_rx_latency(rtimer_clock_t *last, rtimer_clock_t *max)
+{
+    *last = rx_latency_last;
+    *max = rx_latency_max;
+    rx_latency_max = 0;
+}
+#endif
+
+/*---------------------------------------------------------------------------*/
+/*
+ * Polled by the DMA ISR: hand one queued frame to the RDC layer, and poll
+ * again if others are waiting so the remaining processes get their turn.
+ */
+PROCESS_THREAD(cc1101_rf_process, ev, data)
+{
+    PROCESS_BEGIN();
+
+    while(1)
+    {
+        PROCESS_YIELD_UNTIL(ev == PROCESS_EVENT_POLL);
+
+#if TX_ASYNC
+        if(tx_done)
+        {
+            tx_done = 0;
+            if(tx_callback != NULL)
+            {
+                tx_callback(tx_status);
+            }
+        }
+#endif
+
+        if(cc1101_rf_read_packetbuf() > 0)
+        {
+            NETSTACK_RDC.input();
+        }
+
+        if(rx_count > 0)
+        {
+            process_poll(&cc1101_rf_process);
+        }
+    }
+
+    PROCESS_END();
+}
+
+/*---------------------------------------------------------------------------*/
+const struct radio_driver cc1101_rf_driver =
+{
+    init,
+    prepare,
+    transmit,
+    send,
+    read,
+    channel_clear,
+    receiving_packet,
+    pending_packet,
+    on,
+    off,
+};
+/*---------------------------------------------------------------------------*/
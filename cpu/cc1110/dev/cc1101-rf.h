@@ -1,68 +1,166 @@
-/*
- * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
- * All rights reserved.
- *
- */
-
-#ifndef CC1101_RF_H_
-#define CC1101_RF_H_
-
-/*---------------------------------------------------------------------------*/
-#define CC1110_RF_MAX_PACKET_LEN      127
-#define CC1110_RF_MIN_PACKET_LEN        4
-/*---------------------------------------------------------------------------*/
-#define CC1110_RF_CCA_CLEAR             1
-#define CC1110_RF_CCA_BUSY              0
-
-#define SFSTXON 0x00
-#define SCAL    0x01
-#define SRX     0x02
-#define STX     0x03
-#define SIDLE   0x04
-
-// RFIF register
-#define IRQ_TXUNF    0x80
-#define IRQ_RXOVF    0x40
-#define IRQ_TIMEOUT  0x20
-#define IRQ_DONE     0x10 //Packet received/transmitted. Also used to detect underflow/overflow conditions
-#define IRQ_CS       0x08
-#define IRQ_PQT      0x04
-#define IRQ_CCA      0x02
-#define IRQ_SFD      0x01 //Start of Frame Delimiter, sync word detected
-
-#define  SLEEP_STATE 0 //0b00000
-#define  IDLE_STATE  1 //0b00001
-
-#define  VCOON_MC_STATE 3 //0b00011  //MANCAL
-#define  REGON_MC_STATE 4 //0b00100  //MANCAL
-#define  MANCAL_STATE   5 //0b00101 // MANCAL
-
-#define  VCOON_STATE 6 //0b00110 // FS_WAKEUP
-#define  REGON_STATE 7 //0b00111 // FS_WAKEUP
-
-#define  STARTCAL_STATE 8 //0b01000 // CALIBRATE
-#define  ENDCAL_STATE 12 //0b01100 // CALIBRATE
-
-#define  BWBOOST_STATE 9  //0b01001 // SETTLING
-#define  FS_LOCK_STATE 10 //0b01010 // SETTLING
-#define  IFADCON_STATE 11 //0b01011 // SETTLING
-
-#define  RX_STATE 13 //0b01101 // RX_STATE
-#define  RX_END_STATE 14 //0b01110 // RX_STATE
-#define  RX_RST_STATE 15 //0b01111 // RX_STATE
-
-#define  TXRX_SETTLING_STATE 16 //0b10000
-
-#define  RX_OVERFLOW_STATE 17 //0b10001
-
-#define  FSTXON_STATE 18 //0b10010
-
-#define  TX_STATE 19 //0b10011
-#define  TX_END_STATE 20 //0b10100
-
-#define  RXTX_SETTLING_STATE 21 //0b10101
-
-#define  TX_UNDERFLOW_STATE 22 //0b10110
-
-
-#endif /* CC1101_RF_H_ */
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+#ifndef CC1101_RF_H_
+#define CC1101_RF_H_
+
+#include "contiki.h"
+#include "sys/rtimer.h"
+#include "net/rime/rimeaddr.h"
+#include "cc1110.h"
+
+/*---------------------------------------------------------------------------*/
+#define CC1110_RF_MAX_PACKET_LEN      127
+#define CC1110_RF_MIN_PACKET_LEN        4
+/*---------------------------------------------------------------------------*/
+#define CC1110_RF_CCA_CLEAR             1
+#define CC1110_RF_CCA_BUSY              0
+
+#define SFSTXON 0x00
+#define SCAL    0x01
+#define SRX     0x02
+#define STX     0x03
+#define SIDLE   0x04
+
+// RFIF register
+#define IRQ_TXUNF    0x80
+#define IRQ_RXOVF    0x40
+#define IRQ_TIMEOUT  0x20
+#define IRQ_DONE     0x10 //Packet received/transmitted. Also used to detect underflow/overflow conditions
+#define IRQ_CS       0x08
+#define IRQ_PQT      0x04
+#define IRQ_CCA      0x02
+#define IRQ_SFD      0x01 //Start of Frame Delimiter, sync word detected
+
+#define  SLEEP_STATE 0 //0b00000
+#define  IDLE_STATE  1 //0b00001
+
+#define  VCOON_MC_STATE 3 //0b00011  //MANCAL
+#define  REGON_MC_STATE 4 //0b00100  //MANCAL
+#define  MANCAL_STATE   5 //0b00101 // MANCAL
+
+#define  VCOON_STATE 6 //0b00110 // FS_WAKEUP
+#define  REGON_STATE 7 //0b00111 // FS_WAKEUP
+
+#define  STARTCAL_STATE 8 //0b01000 // CALIBRATE
+#define  ENDCAL_STATE 12 //0b01100 // CALIBRATE
+
+#define  BWBOOST_STATE 9  //0b01001 // SETTLING
+#define  FS_LOCK_STATE 10 //0b01010 // SETTLING
+#define  IFADCON_STATE 11 //0b01011 // SETTLING
+
+#define  RX_STATE 13 //0b01101 // RX_STATE
+#define  RX_END_STATE 14 //0b01110 // RX_STATE
+#define  RX_RST_STATE 15 //0b01111 // RX_STATE
+
+#define  TXRX_SETTLING_STATE 16 //0b10000
+
+#define  RX_OVERFLOW_STATE 17 //0b10001
+
+#define  FSTXON_STATE 18 //0b10010
+
+#define  TX_STATE 19 //0b10011
+#define  TX_END_STATE 20 //0b10100
+
+#define  RXTX_SETTLING_STATE 21 //0b10101
+
+#define  TX_UNDERFLOW_STATE 22 //0b10110
+
+/*---------------------------------------------------------------------------*/
+/*
+ * Move the oldest received frame into packetbuf by swapping buffers instead
+ * of copying it. Returns the frame length, 0 if nothing was pending.
+ */
+int cc1101_rf_read_packetbuf(void);
+
+/* Write again the radio registers lost in PM2 */
+void cc1101_rf_restore(void);
+
+/*
+ * 16 bits of RSSI noise, sampled in RX (~2 ms), to seed random_init():
+ * a constant seed gives every node the same LBT backoffs
+ */
+uint16_t cc1101_rf_noise(void);
+
+/* PHY profiles, see cc1101_rf_set_phy() */
+#define CC1101_RF_PHY_1K2     0 /* 1.2 kbps GFSK, long range */
+#define CC1101_RF_PHY_38K4    1 /* 38.4 kbps GFSK */
+#define CC1101_RF_PHY_100K    2 /* 100 kbps GFSK */
+#define CC1101_RF_PHY_250K    3 /* 250 kbps GFSK */
+#define CC1101_RF_PHY_500K    4 /* 500 kbps MSK */
+#define CC1101_RF_PHY_COUNT   5
+
+/*
+ * Switch data rate, deviation and RX filter bandwidth. The radio is
+ * turned off while the modem is programmed and back on if it was.
+ * Returns 0 for an unknown profile or while a frame is going out.
+ */
+int cc1101_rf_set_phy(uint8_t profile);
+
+uint8_t cc1101_rf_get_phy(void);
+
+#if CC1101_RF_CONF_CHANNELS
+/*
+ * Calibrate the synthesizer on every channel and cache the results.
+ * Done by init(); call it again if the temperature drifts a lot.
+ */
+void cc1101_rf_calibrate(void);
+
+/* Hop to another channel using its cached calibration, 0 if not possible */
+int cc1101_rf_set_channel(uint8_t ch);
+
+uint8_t cc1101_rf_get_channel(void);
+#endif
+
+#if CC1101_RF_CONF_ADDR_FILTER
+/*
+ * Program the hardware address filter. Only the last byte of the rime
+ * address is compared: nodes sharing it, or ending in 0x00 or 0xFF, are
+ * told apart by the upper layers only.
+ */
+void cc1101_rf_set_addr(const rimeaddr_t *addr);
+#endif
+
+#if CC1101_RF_CONF_RX_LATENCY
+/*
+ * Time from the end of a frame to its hand over to the RDC layer, in rtimer
+ * ticks: the last one and the worst one since the previous call.
+ */
+void cc1101_rf_rx_latency(rtimer_clock_t *last, rtimer_clock_t *max);
+#endif
+
+#if CC1101_RF_CONF_TX_ASYNC
+/*
+ * With CC1101_RF_CONF_TX_ASYNC and a callback set, NETSTACK_RADIO.send()
+ * returns RADIO_TX_OK as soon as the frame is queued, which only means
+ * that it is on its way: the real RADIO_TX_* outcome (a busy channel is
+ * RADIO_TX_COLLISION) is given to the callback, from the driver process.
+ * Without a callback send() waits and returns the outcome, as with
+ * synchronous transmissions.
+ */
+typedef void (* cc1101_rf_tx_callback_t)(int status);
+
+void cc1101_rf_set_tx_callback(cc1101_rf_tx_callback_t callback);
+
+/*
+ * Send the next frame again and again for 'duration' rtimer ticks from
+ * its first transmission, back to back and without a channel check
+ * after the first one (wake-up strobes). The outcome of the whole train
+ * is reported once. Applies to the next NETSTACK_RADIO.send() only.
+ */
+void cc1101_rf_set_repeat(rtimer_clock_t duration);
+
+/* Times the last frame went on air */
+uint8_t cc1101_rf_tx_count(void);
+#endif
+
+PROCESS_NAME(cc1101_rf_process);
+
+/* The RF ISR recovers RX overflows and ends the DMA transmissions */
+void rfif_isr(void) __interrupt(RF_VECTOR);
+
+
+#endif /* CC1101_RF_H_ */
@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Tickless Sleep Timer control, used by the main loop around sleep
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#ifndef __CLOCK_ARCH_H__
+#define __CLOCK_ARCH_H__
+
+#include "contiki-conf.h"
+
+#if CLOCK_CONF_TICKLESS
+/*
+ * Program EVENT0 at the next etimer expiry, interrupts disabled.
+ * Returns 0 if the wake up is too close to enter PM2
+ */
+uint8_t clock_arch_sleep(void);
+
+/* Back to one EVENT0 every tick after an early wake up */
+void clock_arch_wakeup(void);
+#endif
+
+#endif /* __CLOCK_ARCH_H__ */
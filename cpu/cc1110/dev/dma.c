@@ -1,95 +1,238 @@
-/**
- * \file
- *         Driver for the cc2530 DMA controller. Derived from the cc2430
- *         equivalent
- *
- * \author
- *         Original: Martti Huttunen <martti@sensinode.com>
- *         Port: Zach Shelby <zach@sensinode.com>
- *         Further Modifications:
- *               George Oikonomou <oikonomou@users.sourceforge.net>
- *
- */
-
-#include "contiki.h"
-#include "dev/dma.h"
-#include "cc1110.h"
-
-
-struct dma_config dma_conf[DMA_CHANNEL_COUNT]; /* DMA Descriptors */
-struct process *dma_callback[DMA_CHANNEL_COUNT];
-/*---------------------------------------------------------------------------*/
-void
-dma_init(void)
-{
-  uint16_t tmp_ptr;
-
-  memset(dma_conf, 0, 4 * sizeof(dma_config_t));
-
-  for(tmp_ptr = 0; tmp_ptr < DMA_CHANNEL_COUNT; tmp_ptr++) {
-    dma_callback[tmp_ptr] = 0;
-  }
-
-  /* The address of the descriptor for Channel 0 is configured separately */
-  tmp_ptr = (uint16_t)&(dma_conf[0]);
-  DMA0CFGH = tmp_ptr >> 8;
-  DMA0CFGL = tmp_ptr;
-
-  /*
-   * Descriptors for Channels 1-4 must be consecutive in RAM.
-   * We write the address of the 1st one to the register and the rest are
-   * derived by the SoC
-   */
-#if (DMA_CHANNEL_COUNT > 1)
-  tmp_ptr = (uint16_t)&(dma_conf[1]);
-  DMA1CFGH = tmp_ptr >> 8;
-  DMA1CFGL = tmp_ptr;
-#endif
-
-  DMAIE = 1;	/* Enable DMA interrupts */
-}
-/*---------------------------------------------------------------------------*/
-/*
- * Associate process p with DMA channel c. When a transfer on that channel
- * completes, the ISR will poll this process.
- */
-void
-dma_associate_process(struct process *p, uint8_t c)
-{
-  if((!c) || (c >= DMA_CHANNEL_COUNT)) {
-    return;
-  }
-
-  if(p) {
-    dma_conf[c].inc_prio |= 8; /* Enable interrupt generation */
-    DMAIE = 1; /* Make sure DMA interrupts are acknowledged */
-  }
-  dma_callback[c] = p;
-}
-/*---------------------------------------------------------------------------*/
-/*
- * Reset a channel to idle state. As per cc253x datasheet section 8.1,
- * we must reconfigure the channel to trigger source 0 between each
- * reconfiguration.
- */
-void
-dma_reset(uint8_t c)
-{
-  static __xdata uint8_t dummy;
-  if(c >= DMA_CHANNEL_COUNT) {
-    return;
-  }
-  DMA_ABORT(c);
-  dma_conf[c].src_h = (uint16_t)&dummy >> 8;
-  dma_conf[c].src_l = (uint16_t)&dummy;
-  dma_conf[c].dst_h = (uint16_t)&dummy >> 8;
-  dma_conf[c].dst_l = (uint16_t)&dummy;
-  dma_conf[c].len_h = 0;
-  dma_conf[c].len_l = 1;
-  dma_conf[c].wtt = DMA_BLOCK;
-  dma_conf[c].inc_prio = DMA_PRIO_GUARANTEED;
-  DMA_TRIGGER(c); /** The operation order is important */
-  DMA_ARM(c);
-  while(DMAARM & (1 << c));
-}
-
+/**
+ * \file
+ *         Driver for the cc2530 DMA controller. Derived from the cc2430
+ *         equivalent
+ *
+ * \author
+ *         Original: Martti Huttunen <martti@sensinode.com>
+ *         Port: Zach Shelby <zach@sensinode.com>
+ *         Further Modifications:
+ *               George Oikonomou <oikonomou@users.sourceforge.net>
+ *
+ */
+
+#include "contiki.h"
+#include "dev/dma.h"
+#include "cc1110.h"
+
+#include <string.h>
+
+struct dma_config dma_conf[DMA_CHANNEL_COUNT]; /* DMA Descriptors */
+struct process *dma_callback[DMA_CHANNEL_COUNT];
+dma_callback_t dma_isr_callback[DMA_CHANNEL_COUNT];
+void *dma_isr_ptr[DMA_CHANNEL_COUNT];
+
+volatile uint8_t dma_used;      /* channels taken, one bit each */
+volatile uint8_t dma_oneshot;   /* released by the ISR at the end */
+/*---------------------------------------------------------------------------*/
+void
+dma_init(void)
+{
+  uint16_t tmp_ptr;
+
+  memset(dma_conf, 0, sizeof(dma_conf));
+
+  for(tmp_ptr = 0; tmp_ptr < DMA_CHANNEL_COUNT; tmp_ptr++) {
+    dma_callback[tmp_ptr] = 0;
+    dma_isr_callback[tmp_ptr] = 0;
+  }
+
+  /* Channels with a fixed role are never handed out */
+  dma_used = 0;
+  dma_oneshot = 0;
+#ifdef DMA_RADIO_CHANNEL
+  dma_used |= 1 << DMA_RADIO_CHANNEL;
+#endif
+#ifdef DMA_RADIO_TX_CHANNEL
+  dma_used |= 1 << DMA_RADIO_TX_CHANNEL;
+#endif
+#ifdef DMA_AES_IN_CHANNEL
+  dma_used |= (1 << DMA_AES_IN_CHANNEL) | (1 << DMA_AES_OUT_CHANNEL);
+#endif
+
+  /* The address of the descriptor for Channel 0 is configured separately */
+  tmp_ptr = (uint16_t)&(dma_conf[0]);
+  DMA0CFGH = tmp_ptr >> 8;
+  DMA0CFGL = tmp_ptr;
+
+  /*
+   * Descriptors for Channels 1-4 must be consecutive in RAM.
+   * We write the address of the 1st one to the register and the rest are
+   * derived by the SoC
+   */
+#if (DMA_CHANNEL_COUNT > 1)
+  tmp_ptr = (uint16_t)&(dma_conf[1]);
+  DMA1CFGH = tmp_ptr >> 8;
+  DMA1CFGL = tmp_ptr;
+#endif
+
+  DMAIE = 1;	/* Enable DMA interrupts */
+}
+/*---------------------------------------------------------------------------*/
+/*
+ * Associate process p with DMA channel c. When a transfer on that channel
+ * completes, the ISR will poll this process.
+ * Channel 0 is the radio RX channel, its process is the radio driver one.
+ */
+void
+dma_associate_process(struct process *p, uint8_t c)
+{
+  if(c >= DMA_CHANNEL_COUNT) {
+    return;
+  }
+
+  if(p) {
+    dma_conf[c].inc_prio |= 8; /* Enable interrupt generation */
+    DMAIE = 1; /* Make sure DMA interrupts are acknowledged */
+  }
+  dma_callback[c] = p;
+}
+/*---------------------------------------------------------------------------*/
+/*
+ * Call f(ptr) from the DMA ISR when a transfer on channel c completes.
+ * Keep it short, interrupts are off, and with banking f must be in HOME.
+ */
+void
+dma_associate_callback(uint8_t c, dma_callback_t f, void *ptr)
+{
+  if(c >= DMA_CHANNEL_COUNT) {
+    return;
+  }
+
+  if(f) {
+    dma_conf[c].inc_prio |= DMA_IRQ_MASK_ENABLE;
+    DMAIE = 1;
+  }
+  dma_isr_ptr[c] = ptr;
+  dma_isr_callback[c] = f;
+}
+/*---------------------------------------------------------------------------*/
+int8_t
+dma_alloc(void)
+{
+  int8_t c;
+  uint8_t ea;
+
+  /* may be called with interrupts already disabled */
+  ea = EA;
+  EA = 0;
+  for(c = 0; c < DMA_CHANNEL_COUNT; c++) {
+    if(!(dma_used & (1 << c))) {
+      dma_used |= 1 << c;
+      break;
+    }
+  }
+  EA = ea;
+
+  return c < DMA_CHANNEL_COUNT ? c : -1;
+}
+/*---------------------------------------------------------------------------*/
+void
+dma_free(uint8_t c)
+{
+  uint8_t ea;
+
+  if(c >= DMA_CHANNEL_COUNT) {
+    return;
+  }
+
+  ea = EA;
+  EA = 0;
+  DMA_ABORT(c);
+  DMAIRQ = ~(1 << c);
+  dma_callback[c] = 0;
+  dma_isr_callback[c] = 0;
+  dma_oneshot &= ~(1 << c);
+  dma_used &= ~(1 << c);
+  EA = ea;
+}
+/*---------------------------------------------------------------------------*/
+/* Block transfer of len bytes started by software, at low priority */
+static void
+dma_copy_setup(uint8_t c, __xdata void *dst, const __xdata void *src,
+               uint16_t len)
+{
+  dma_conf[c].src_h = (uint16_t)src >> 8;
+  dma_conf[c].src_l = (uint16_t)src;
+  dma_conf[c].dst_h = (uint16_t)dst >> 8;
+  dma_conf[c].dst_l = (uint16_t)dst;
+  dma_conf[c].len_h = DMA_VLEN_LEN | ((len >> 8) & 0x1F);
+  dma_conf[c].len_l = len;
+  dma_conf[c].wtt = DMA_BLOCK | DMA_T_NONE;
+  dma_conf[c].inc_prio = DMA_SRC_INC_1 | DMA_DST_INC_1 | DMA_PRIO_LOW;
+}
+/*---------------------------------------------------------------------------*/
+static void
+dma_start(uint8_t c)
+{
+  DMA_ARM(c);
+  DMA_ARM_WAIT();
+  DMA_TRIGGER(c);
+}
+/*---------------------------------------------------------------------------*/
+void
+dma_memcpy(__xdata void *dst, const __xdata void *src, uint16_t len)
+{
+  int8_t c;
+
+  if(len == 0 || len < DMA_MEMCPY_MIN || (c = dma_alloc()) < 0) {
+    memmove(dst, src, len);
+    return;
+  }
+
+  dma_copy_setup(c, dst, src, len);
+  dma_start(c);
+  while(DMAARM & (1 << c));
+  dma_free(c);
+}
+/*---------------------------------------------------------------------------*/
+int8_t
+dma_memcpy_async(__xdata void *dst, const __xdata void *src, uint16_t len,
+                 struct process *p)
+{
+  int8_t c;
+  uint8_t ea;
+
+  if(len == 0 || (c = dma_alloc()) < 0) {
+    return -1;
+  }
+
+  dma_copy_setup(c, dst, src, len);
+  dma_conf[c].inc_prio |= DMA_IRQ_MASK_ENABLE;
+  dma_callback[c] = p;
+  ea = EA;
+  EA = 0;
+  dma_oneshot |= 1 << c;
+  EA = ea;
+  DMAIE = 1;
+  dma_start(c);
+
+  return c;
+}
+/*---------------------------------------------------------------------------*/
+/*
+ * Reset a channel to idle state. As per cc253x datasheet section 8.1,
+ * we must reconfigure the channel to trigger source 0 between each
+ * reconfiguration.
+ */
+void
+dma_reset(uint8_t c)
+{
+  static __xdata uint8_t dummy;
+  if(c >= DMA_CHANNEL_COUNT) {
+    return;
+  }
+  DMA_ABORT(c);
+  dma_conf[c].src_h = (uint16_t)&dummy >> 8;
+  dma_conf[c].src_l = (uint16_t)&dummy;
+  dma_conf[c].dst_h = (uint16_t)&dummy >> 8;
+  dma_conf[c].dst_l = (uint16_t)&dummy;
+  dma_conf[c].len_h = 0;
+  dma_conf[c].len_l = 1;
+  dma_conf[c].wtt = DMA_BLOCK;
+  dma_conf[c].inc_prio = DMA_PRIO_GUARANTEED;
+  DMA_TRIGGER(c); /** The operation order is important */
+  DMA_ARM(c);
+  while(DMAARM & (1 << c));
+}
+
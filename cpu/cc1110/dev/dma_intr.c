@@ -1,84 +1,103 @@
-/**
- * \file
- *         DMA driver ISRs
- * \author
- *         Original: Martti Huttunen <martti@sensinode.com>
- *         Port: Zach Shelby <zach@sensinode.com>
- *
- *         DMA interrupt routines, must be stored in HOME bank
- */
-
-#include <stdio.h>
-
-#include "contiki.h"
-
-#include "dev/dma.h"
-#include "cc1110.h"
-
-#if DMA_ON
-extern struct process *dma_callback[DMA_CHANNEL_COUNT];
-#endif
-
-/*---------------------------------------------------------------------------*/
-#ifdef HAVE_RF_DMA
-extern void rf_dma_callback_isr(void);
-#endif
-#ifdef SPI_DMA_RX
-extern void spi_rx_dma_callback(void);
-#endif
-
-/*---------------------------------------------------------------------------*/
-/**
- * DMA interrupt service routine.
- *
- * if callback defined a poll is made to that process
- */
-/* Avoid referencing bits, we don't call code which use them
-
- */
-#pragma save
-#if CC_CONF_OPTIMIZE_STACK_SIZE
-#pragma exclude bits
-#endif
-void
-dma_isr(void) __interrupt(DMA_VECTOR)
-{
-
-  //uint8_t i;
-
-  EA = 0;
-  DMAIF = 0;
-
-  if((DMAIRQ & 1) != 0) {
-    // channel 0 has triggered a DMA signal, clear DMAIRQ.DMAIF0 (channel 0)
-    DMAIRQ &= ~1;
-
-    // abort channel 0
-    DMAARM = 0x81;
-
-    rf_dma_callback_isr();
-  }
-
-#if 0
- #ifdef SPI_DMA_RX
-  if((DMAIRQ & 0x08) != 0) {
-    DMAIRQ &= ~(1 << 3);
-    spi_rx_dma_callback();
-  }
- #endif
- #if DMA_ON
-  for(i = 0; i < DMA_CHANNEL_COUNT; i++) {
-    if((DMAIRQ & (1 << i)) != 0) {
-      DMAIRQ = ~(1 << i);
-      if(dma_callback[i] != 0) {
-        process_poll(dma_callback[i]);
-      }
-    }
-  }
- #endif
-#endif
-  EA = 1;
-}
-#pragma restore
-/*---------------------------------------------------------------------------*/
-
+/**
+ * \file
+ *         DMA driver ISRs
+ * \author
+ *         Original: Martti Huttunen <martti@sensinode.com>
+ *         Port: Zach Shelby <zach@sensinode.com>
+ *
+ *         DMA interrupt routines, must be stored in HOME bank
+ */
+
+#include <stdio.h>
+
+#include "contiki.h"
+
+#include "dev/dma.h"
+#include "cc1110.h"
+
+#if DMA_ON
+extern struct process *dma_callback[DMA_CHANNEL_COUNT];
+extern dma_callback_t dma_isr_callback[DMA_CHANNEL_COUNT];
+extern void *dma_isr_ptr[DMA_CHANNEL_COUNT];
+extern volatile uint8_t dma_used;
+extern volatile uint8_t dma_oneshot;
+#endif
+
+/*---------------------------------------------------------------------------*/
+#ifdef HAVE_RF_DMA
+extern void rf_dma_callback_isr(void);
+#endif
+#ifdef SPI_DMA_RX
+extern void spi_rx_dma_callback(void);
+#endif
+
+/*---------------------------------------------------------------------------*/
+/**
+ * DMA interrupt service routine.
+ *
+ * The radio RX channel goes straight to the radio driver, then for every
+ * channel that completed the callback is called and the process polled.
+ * Channels of dma_memcpy_async() are released here.
+ */
+/* Avoid referencing bits, we don't call code which use them
+
+ */
+#pragma save
+#if CC_CONF_OPTIMIZE_STACK_SIZE
+#pragma exclude bits
+#endif
+void
+dma_isr(void) __interrupt(DMA_VECTOR)
+{
+
+#if DMA_ON
+  uint8_t i;
+#endif
+
+  EA = 0;
+  DMAIF = 0;
+
+#ifdef DMA_RADIO_CHANNEL
+  if((DMAIRQ & (1 << DMA_RADIO_CHANNEL)) != 0) {
+    DMAIRQ = ~(1 << DMA_RADIO_CHANNEL);
+
+    DMA_ABORT(DMA_RADIO_CHANNEL);
+
+    rf_dma_callback_isr();
+    if(dma_callback[DMA_RADIO_CHANNEL] != 0) {
+      process_poll(dma_callback[DMA_RADIO_CHANNEL]);
+    }
+  }
+#endif
+
+#if 0
+ #ifdef SPI_DMA_RX
+  if((DMAIRQ & 0x08) != 0) {
+    DMAIRQ &= ~(1 << 3);
+    spi_rx_dma_callback();
+  }
+ #endif
+#endif
+#if DMA_ON
+  for(i = 0; i < DMA_CHANNEL_COUNT; i++) {
+    if((DMAIRQ & (1 << i)) != 0) {
+      DMAIRQ = ~(1 << i);
+      if(dma_isr_callback[i] != 0) {
+        dma_isr_callback[i](dma_isr_ptr[i]);
+      }
+      if(dma_callback[i] != 0) {
+        process_poll(dma_callback[i]);
+      }
+      if(dma_oneshot & (1 << i)) {
+        dma_oneshot &= ~(1 << i);
+        dma_callback[i] = 0;
+        dma_used &= ~(1 << i);
+      }
+    }
+  }
+#endif
+  EA = 1;
+}
+#pragma restore
+/*---------------------------------------------------------------------------*/
+
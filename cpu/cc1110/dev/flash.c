@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Flash controller driver, see flash.h
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#include "contiki.h"
+#include "dev/flash.h"
+#include "dev/dma.h"
+#include "cc1110.h"
+#include "sfr-bits.h"
+
+#include <string.h>
+
+/* Flash write timing for a 26 MHz system clock: 21000 * F / 16e9 */
+#define FLASH_FWT 0x22
+
+/*
+ * Start the operation in FCTL and wait for its end. Copied to SRAM, which
+ * the cc1110 also maps in code space at the same address, before every
+ * call: SRAM only partially survives PM2.
+ */
+#define RUN_CMD 2 /* the operand of the orl */
+static __code const uint8_t run_code[] =
+{
+    0x43, 0xAE, 0x00, /*       orl  FCTL, #cmd */
+    0x00,             /*       nop             */
+    0xE5, 0xAE,       /* wait: mov  a, FCTL    */
+    0x20, 0xE7, 0xFB, /*       jb   acc.7, wait (FCTL_BUSY) */
+    0x22,             /*       ret             */
+};
+static __xdata uint8_t run_ram[sizeof(run_code)];
+/*---------------------------------------------------------------------------*/
+static void
+run(uint8_t cmd)
+{
+    uint8_t ea;
+
+    memcpy(run_ram, run_code, sizeof(run_code));
+    run_ram[RUN_CMD] = cmd;
+
+    ea = EA;
+    EA = 0;
+    ((void (__code *)(void))(uint16_t)run_ram)();
+    EA = ea;
+}
+/*---------------------------------------------------------------------------*/
+void
+flash_erase(uint16_t addr)
+{
+    FWT = FLASH_FWT;
+    // FADDR is a word address, FADDRH[5:1] the page
+    FADDRH = (addr / FLASH_PAGE_SIZE) << 1;
+    FADDRL = 0;
+    run(FCTL_ERASE);
+}
+/*---------------------------------------------------------------------------*/
+int
+flash_write(uint16_t addr, const __xdata uint8_t *buf, uint16_t len)
+{
+    int8_t c;
+
+#ifdef DMA_FLASH_CHANNEL
+    c = DMA_FLASH_CHANNEL;
+#else
+    if((c = dma_alloc()) < 0)
+    {
+        return 0;
+    }
+#endif
+
+    // the controller asks for the next byte with the FLASH trigger
+    dma_conf[c].src_h = (uint16_t)buf >> 8;
+    dma_conf[c].src_l = (uint16_t)buf;
+    dma_conf[c].dst_h = (uint16_t)&X_FWDATA >> 8;
+    dma_conf[c].dst_l = (uint16_t)&X_FWDATA;
+    dma_conf[c].len_h = DMA_VLEN_LEN | ((len >> 8) & 0x1F);
+    dma_conf[c].len_l = len;
+    dma_conf[c].wtt = DMA_SINGLE | DMA_T_FLASH;
+    dma_conf[c].inc_prio = DMA_SRC_INC_1 | DMA_DST_INC_NO | DMA_PRIO_HIGH;
+
+    FWT = FLASH_FWT;
+    FADDRH = (addr >> 1) >> 8;
+    FADDRL = addr >> 1;
+    DMA_ARM(c);
+    run(FCTL_WRITE);
+
+#ifndef DMA_FLASH_CHANNEL
+    dma_free(c);
+#endif
+    return 1;
+}
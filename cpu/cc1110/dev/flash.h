@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Flash pages kept for data: erase and write with the flash
+ *         controller, read as code memory.
+ *
+ *         The pages are reserved at link time with FLASH_DATA_PAGES in the
+ *         project Makefile (see Makefile.cc1110), which defines
+ *         FLASH_CONF_DATA_START and FLASH_CONF_DATA_PAGES.
+ *
+ *         The CPU cannot fetch code from flash while the controller erases
+ *         or writes it, so the routine that starts the operation and waits
+ *         for its end runs from SRAM, with the interrupts off: a page erase
+ *         holds them for ~20 ms.
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#ifndef FLASH_H_
+#define FLASH_H_
+
+#include "contiki.h"
+
+#define FLASH_PAGE_SIZE 1024
+
+#ifdef FLASH_CONF_DATA_START
+#define FLASH_DATA_START FLASH_CONF_DATA_START
+#define FLASH_DATA_PAGES FLASH_CONF_DATA_PAGES
+#endif
+
+/* Read a flash byte */
+#define FLASH_READ(addr) (*(__code const uint8_t *)(addr))
+
+/* Erase the page holding 'addr': every byte reads 0xFF */
+void flash_erase(uint16_t addr);
+
+/*
+ * Write 'len' bytes from XDATA, 'addr' and 'len' even. A bit goes from 1
+ * to 0 only: write erased words. It takes the DMA_FLASH_CHANNEL the
+ * platform sets aside, otherwise a free one: 0 if none is free.
+ */
+int flash_write(uint16_t addr, const __xdata uint8_t *buf, uint16_t len);
+
+#endif /* FLASH_H_ */
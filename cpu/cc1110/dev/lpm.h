@@ -1,59 +1,62 @@
-/*
- * Copyright (c) 2010, Loughborough University - Computer Science
- * All rights reserved.
- *
- * Redistribution and use in source and binary forms, with or without
- * modification, are permitted provided that the following conditions
- * are met:
- * 1. Redistributions of source code must retain the above copyright
- *    notice, this list of conditions and the following disclaimer.
- * 2. Redistributions in binary form must reproduce the above copyright
- *    notice, this list of conditions and the following disclaimer in the
- *    documentation and/or other materials provided with the distribution.
- * 3. Neither the name of the Institute nor the names of its contributors
- *    may be used to endorse or promote products derived from this software
- *    without specific prior written permission.
- *
- * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
- * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
- * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
- * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
- * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
- * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
- * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
- * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
- * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
- * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
- * SUCH DAMAGE.
- *
- * This file is part of the Contiki operating system.
- */
-
-/**
- * \file
- *         Header file for the cc2430 Low Power Modes (LPM)
- *         We currently support the following:
- *           - Set MCU IDLE while in PM0. This is working as intended
- *           - Drop to PM1. This results in incoming radio packet losses.
- *
- * \author
- *         George Oikonomou - <oikonomou@users.sourceforge.net>
- */
-#ifndef __LPM_H__
-#define __LPM_H__
-
-#include "contiki-conf.h"
-
-#define LPM_MODE_NONE 0 /* No LPM - Always on */
-#define LPM_MODE_IDLE 1 /* Set MCU Idle as part of the main loop */
-
-#define LPM_MODE_PM1  2
-#define LPM_MODE_PM2  3 /* causes radio packet losses for now */
-
-#ifdef LPM_CONF_MODE
-#define LPM_MODE LPM_CONF_MODE
-#else
-#define LPM_MODE LPM_MODE_IDLE
-#endif /* LPM_CONF_MODE */
-
-#endif /* __LPM_H__ */
+/*
+ * Copyright (c) 2010, Loughborough University - Computer Science
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ */
+
+/**
+ * \file
+ *         Header file for the cc1110 Low Power Modes (LPM)
+ *         We currently support the following:
+ *           - Set MCU IDLE while in PM0. This is working as intended
+ *           - Drop to PM1 or PM2. The radio and the DMA stop without the
+ *             HS XOSC, so the main loop only does it while the radio is
+ *             idle and no DMA channel is armed, and goes IDLE otherwise.
+ *             Serial input is not received in PM1/PM2.
+ *
+ * \author
+ *         George Oikonomou - <oikonomou@users.sourceforge.net>
+ */
+#ifndef __LPM_H__
+#define __LPM_H__
+
+#include "contiki-conf.h"
+
+#define LPM_MODE_NONE 0 /* No LPM - Always on */
+#define LPM_MODE_IDLE 1 /* Set MCU Idle as part of the main loop */
+
+#define LPM_MODE_PM1  2
+#define LPM_MODE_PM2  3
+
+#ifdef LPM_CONF_MODE
+#define LPM_MODE LPM_CONF_MODE
+#else
+#define LPM_MODE LPM_MODE_IDLE
+#endif /* LPM_CONF_MODE */
+
+#endif /* __LPM_H__ */
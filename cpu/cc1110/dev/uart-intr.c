@@ -1,80 +1,138 @@
-/**
- * \file
- *
- *   uart write routines
- *
- * \author
- *
- *   Anthony "Asterisk" Ambuehl
- *
- *   interrupt routines which must be in HOME bank.  handles received data from UART.
- *
- */
-#include "cc1110.h"
-
-#include "dev/uart0.h"
-#include "dev/uart1.h"
-#include "sys/energest.h"
-
-#if UART0_ENABLE
-static int (* uart0_input_handler)(unsigned char c);
-#endif
-#if UART1_ENABLE
-static int (* uart1_input_handler)(unsigned char c);
-#endif
-
-#if UART0_ENABLE
-/*---------------------------------------------------------------------------*/
-void
-uart0_set_input(int (* input)(unsigned char c))
-{
-  uart0_input_handler = input;
-}
-/*---------------------------------------------------------------------------*/
-#if UART0_CONF_WITH_INPUT
-/* avoid referencing bits since we're not using them */
-#pragma save
-#if CC_CONF_OPTIMIZE_STACK_SIZE
-#pragma exclude bits
-#endif
-void
-uart0_rx_isr(void) __interrupt(URX0_VECTOR)
-{
-  ENERGEST_ON(ENERGEST_TYPE_IRQ);
-  URX0IF = 0;
-  if(uart0_input_handler != NULL) {
-    uart0_input_handler(U0DBUF);
-  }
-  ENERGEST_OFF(ENERGEST_TYPE_IRQ);
-}
-#pragma restore
-#endif
-#endif /* UART0_ENABLE */
-#if UART1_ENABLE
-/*---------------------------------------------------------------------------*/
-void
-uart1_set_input(int (* input)(unsigned char c))
-{
-  uart1_input_handler = input;
-}
-/*---------------------------------------------------------------------------*/
-#if UART_ONE_CONF_WITH_INPUT
-/* avoid referencing bits since we're not using them */
-#pragma save
-#if CC_CONF_OPTIMIZE_STACK_SIZE
-#pragma exclude bits
-#endif
-void
-uart1_rx_isr(void) __interrupt(URX1_VECTOR)
-{
-  ENERGEST_ON(ENERGEST_TYPE_IRQ);
-  URX1IF = 0;
-  if(uart1_input_handler != NULL) {
-    uart1_input_handler(U1DBUF);
-  }
-  ENERGEST_OFF(ENERGEST_TYPE_IRQ);
-}
-#pragma restore
-/*---------------------------------------------------------------------------*/
-#endif /* UART_ONE_CONF_WITH_INPUT */
-#endif /* UART1_ENABLE */
+/**
+ * \file
+ *
+ *   uart write routines
+ *
+ * \author
+ *
+ *   Anthony "Asterisk" Ambuehl
+ *
+ *   interrupt routines which must be in HOME bank.  handles received data from UART.
+ *
+ */
+#include "contiki.h"
+#include "cc1110.h"
+
+#include "dev/uart0.h"
+#include "dev/uart1.h"
+#include "sys/energest.h"
+
+#if UART0_ENABLE
+static int (* uart0_input_handler)(unsigned char c);
+#endif
+#if UART0_RX_RING
+/*
+ * RX ring between the ISR and uart0_rx_process, indexes running free.
+ * When it is full the ISR leaves the byte in U0DBUF and masks itself:
+ * with UART0_RTSCTS the full receive register keeps RTS up and the other
+ * side waits, without it the next bytes overrun.
+ */
+#define RX_MASK (UART0_RX_RING - 1)
+
+static __xdata uint8_t rx_ring[UART0_RX_RING];
+static volatile uint8_t rx_head;
+static volatile uint8_t rx_tail;
+
+PROCESS(uart0_rx_process, "UART0 RX");
+#endif
+#if UART1_ENABLE
+static int (* uart1_input_handler)(unsigned char c);
+#endif
+
+#if UART0_ENABLE
+/*---------------------------------------------------------------------------*/
+void
+uart0_set_input(int (* input)(unsigned char c))
+{
+  uart0_input_handler = input;
+}
+/*---------------------------------------------------------------------------*/
+#if UART0_CONF_WITH_INPUT
+/* avoid referencing bits since we're not using them */
+#pragma save
+#if CC_CONF_OPTIMIZE_STACK_SIZE
+#pragma exclude bits
+#endif
+void
+uart0_rx_isr(void) __interrupt(URX0_VECTOR)
+{
+  ENERGEST_ON(ENERGEST_TYPE_IRQ);
+  URX0IF = 0;
+#if UART0_RX_RING
+  if((uint8_t)(rx_head - rx_tail) == UART0_RX_RING) {
+    URX0IE = 0;
+  } else {
+    rx_ring[rx_head & RX_MASK] = U0DBUF;
+    rx_head++;
+  }
+  process_poll(&uart0_rx_process);
+#else
+  if(uart0_input_handler != NULL) {
+    uart0_input_handler(U0DBUF);
+  }
+#endif
+  ENERGEST_OFF(ENERGEST_TYPE_IRQ);
+}
+#pragma restore
+#endif
+#if UART0_RX_RING
+/*---------------------------------------------------------------------------*/
+/* Feed serial_line / slip with everything the ISR queued */
+PROCESS_THREAD(uart0_rx_process, ev, data)
+{
+  uint8_t c;
+
+  PROCESS_BEGIN();
+
+  while(1) {
+    PROCESS_YIELD_UNTIL(ev == PROCESS_EVENT_POLL);
+
+    while(rx_tail != rx_head) {
+      c = rx_ring[rx_tail & RX_MASK];
+      rx_tail++;
+      if(uart0_input_handler != NULL) {
+        uart0_input_handler(c);
+      }
+    }
+
+    /* The ISR stopped on a full ring: take the byte it left behind */
+    if(!URX0IE) {
+      rx_ring[rx_head & RX_MASK] = U0DBUF;
+      rx_head++;
+      URX0IE = 1;
+      process_poll(&uart0_rx_process);
+    }
+  }
+
+  PROCESS_END();
+}
+#endif
+#endif /* UART0_ENABLE */
+#if UART1_ENABLE
+/*---------------------------------------------------------------------------*/
+void
+uart1_set_input(int (* input)(unsigned char c))
+{
+  uart1_input_handler = input;
+}
+/*---------------------------------------------------------------------------*/
+#if UART_ONE_CONF_WITH_INPUT
+/* avoid referencing bits since we're not using them */
+#pragma save
+#if CC_CONF_OPTIMIZE_STACK_SIZE
+#pragma exclude bits
+#endif
+void
+uart1_rx_isr(void) __interrupt(URX1_VECTOR)
+{
+  ENERGEST_ON(ENERGEST_TYPE_IRQ);
+  URX1IF = 0;
+  if(uart1_input_handler != NULL) {
+    uart1_input_handler(U1DBUF);
+  }
+  ENERGEST_OFF(ENERGEST_TYPE_IRQ);
+}
+#pragma restore
+/*---------------------------------------------------------------------------*/
+#endif /* UART_ONE_CONF_WITH_INPUT */
+#endif /* UART1_ENABLE */
@@ -1,74 +1,226 @@
-/**
- * \file
- *
- *   uart0 write routines
- *
- * \author
- *
- *   Anthony "Asterisk" Ambuehl
- *
- */
-#include <stdlib.h>
-#include <string.h>
-
-#include "cc1110.h"
-#include "sfr-bits.h"
-#include "dev/uart0.h"
-
-#if UART0_ENABLE
-/*---------------------------------------------------------------------------*/
-void
-uart0_init()
-{
-#if UART0_CONF_HIGH_SPEED
-  UART_SET_SPEED(0, UART_115_M, UART_115_E);
-#else
-  UART_SET_SPEED(0, UART_9_M, UART_9_E);
-#endif
-
-#ifdef UART0_ALTERNATIVE_2
-  PERCFG |= PERCFG_U0CFG;  / *alternative port 2 = P1.5-2 */
-#ifdef UART0_RTSCTS
-  P1SEL |= 0x3C;    /* peripheral select for TX and RX, RTS, CTS */
-#else
-  P1SEL |= 0x30;    /* peripheral select for TX and RX */
-  P1 &= ~0x08;      /* RTS down */
-#endif
-  P1DIR |= 0x28;    /* RTS, TX out */
-  P1DIR &= ~0x14;   /* CTS & RX in */
-#else
-  PERCFG &= ~PERCFG_U0CFG; /* alternative port 1 = P0.5-2 */
-#ifdef UART0_RTSCTS
-  P0SEL |= 0x20 | 0x10;    /* peripheral select for TX and RX */
-#else
-  P0SEL |= 0x0C;    /* peripheral select for TX and RX */
-  P0 &= ~0x20;    /* RTS down */
-#endif
-  P0DIR |= 0x28;    /* RTS, TX out */
-  P0DIR &= ~0x14;   /* CTS, RX in */
-#endif
-
-
-#ifdef UART0_RTSCTS
-  U0UCR = 0x42; /*defaults: 8N1, RTS/CTS, high stop bit*/
-#else
-  U0UCR = 0x02; /*defaults: 8N1, no flow control, high stop bit*/
-#endif
-
-  U0CSR = UCSR_MODE; /* UART mode */
-  U0UCR |= 0x80; /* Flush */
-  UART0_RX_EN();
-
-  UART0_RX_INT(1);
-}
-/*---------------------------------------------------------------------------*/
-/* Write one byte over the UART. */
-void
-uart0_writeb(uint8_t byte)
-{
-  UTX0IF = 0;
-  U0DBUF = byte;
-  while(!UTX0IF); /* Wait until byte has been transmitted. */
-  UTX0IF = 0;
-}
-#endif
+/**
+ * \file
+ *
+ *   uart0 write routines
+ *
+ * \author
+ *
+ *   Anthony "Asterisk" Ambuehl
+ *
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "cc1110.h"
+#include "sfr-bits.h"
+#include "dev/uart0.h"
+#include "dev/dma.h"
+
+#if UART0_ENABLE
+#if UART0_TX_DMA
+/*
+ * TX ring, drained by a DMA channel triggered by UTX0: the channel moves
+ * the bytes from tx_tail up to tx_head (or the end of the ring) and the
+ * DMA ISR hands it the next ones. The indexes run free, their difference
+ * is the number of bytes queued.
+ */
+#define TX_MASK (UART0_TX_BUF - 1)
+
+static __xdata uint8_t tx_ring[UART0_TX_BUF];
+static volatile uint8_t tx_head;
+static volatile uint8_t tx_tail;
+static volatile uint8_t tx_len;   /* bytes the DMA is moving, 0 when idle */
+static int8_t tx_dma;
+/*---------------------------------------------------------------------------*/
+/* Give the DMA the next run of bytes, if any. Interrupts disabled */
+static void
+tx_next(void)
+{
+  uint8_t t = tx_tail & TX_MASK;
+
+  tx_len = tx_head - tx_tail;
+  if(tx_len > UART0_TX_BUF - t) {
+    tx_len = UART0_TX_BUF - t;
+  }
+  if(tx_len == 0) {
+    return;
+  }
+
+  dma_conf[tx_dma].src_h = (uint16_t)&tx_ring[t] >> 8;
+  dma_conf[tx_dma].src_l = (uint16_t)&tx_ring[t];
+  dma_conf[tx_dma].len_l = tx_len;
+  DMA_ARM(tx_dma);
+}
+/*---------------------------------------------------------------------------*/
+/*
+ * The last byte is out: UTX0IF, or an idle USART when the flag was
+ * cleared after the byte ended. ACTIVE is also set by a byte coming in,
+ * that only makes the wait longer.
+ */
+#define TX_IDLE() (UTX0IF || !(U0CSR & UCSR_ACTIVE))
+/*---------------------------------------------------------------------------*/
+/*
+ * DMA ISR: the last byte of the run is in U0DBUF. Its UTX0 trigger starts
+ * the next run, and with none queued UTX0IF tells when it is out.
+ * UTX0IF is still set by the byte before, so it is cleared here. If the
+ * ISR ran late the last byte may be out already: its trigger came before
+ * the arm and its flag is gone, the USART idle tells.
+ */
+static void
+tx_done(void *ptr)
+{
+  tx_tail += tx_len;
+  UTX0IF = 0;
+  tx_next();
+  if(tx_len != 0) {
+    DMA_ARM_WAIT();
+    if(!(U0CSR & UCSR_ACTIVE)) {
+      DMA_TRIGGER(tx_dma);
+    }
+  } else if(!(U0CSR & UCSR_ACTIVE)) {
+    UTX0IF = 1;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+tx_dma_init(void)
+{
+  tx_head = tx_tail = tx_len = 0;
+  UTX0IF = 1; /* nothing on the line */
+
+  /* No channel left: uart0_writeb() polls as without UART0_TX_DMA */
+  tx_dma = dma_alloc();
+  if(tx_dma < 0) {
+    return;
+  }
+
+  dma_conf[tx_dma].dst_h = (uint16_t)&X_U0DBUF >> 8;
+  dma_conf[tx_dma].dst_l = (uint16_t)&X_U0DBUF;
+  dma_conf[tx_dma].len_h = DMA_VLEN_LEN;
+  dma_conf[tx_dma].wtt = DMA_SINGLE | DMA_T_UTX0;
+  dma_conf[tx_dma].inc_prio = DMA_SRC_INC_1 | DMA_DST_INC_NO | DMA_PRIO_LOW;
+  dma_associate_callback(tx_dma, tx_done, NULL);
+}
+#endif /* UART0_TX_DMA */
+/*---------------------------------------------------------------------------*/
+void
+uart0_init()
+{
+#if UART0_CONF_HIGH_SPEED == 2
+  UART_SET_SPEED(0, UART_230_M, UART_230_E);
+#elif UART0_CONF_HIGH_SPEED
+  UART_SET_SPEED(0, UART_115_M, UART_115_E);
+#else
+  UART_SET_SPEED(0, UART_9_M, UART_9_E);
+#endif
+
+#ifdef UART0_ALTERNATIVE_2
+  PERCFG |= PERCFG_U0CFG;  /* alternative port 2 = P1.5-2 */
+#ifdef UART0_RTSCTS
+  P1SEL |= 0x3C;    /* peripheral select for TX and RX, RTS, CTS */
+#else
+  P1SEL |= 0x30;    /* peripheral select for TX and RX */
+  P1 &= ~0x08;      /* RTS down */
+#endif
+  P1DIR |= 0x28;    /* RTS, TX out */
+  P1DIR &= ~0x14;   /* CTS & RX in */
+#else
+  PERCFG &= ~PERCFG_U0CFG; /* alternative port 1 = P0.5-2 */
+#ifdef UART0_RTSCTS
+  P0SEL |= 0x3C;    /* peripheral select for TX and RX, RTS, CTS */
+#else
+  P0SEL |= 0x0C;    /* peripheral select for TX and RX */
+  P0 &= ~0x20;    /* RTS down */
+#endif
+  P0DIR |= 0x28;    /* RTS, TX out */
+  P0DIR &= ~0x14;   /* CTS, RX in */
+#endif
+
+
+#ifdef UART0_RTSCTS
+  U0UCR = 0x42; /*defaults: 8N1, RTS/CTS, high stop bit*/
+#else
+  U0UCR = 0x02; /*defaults: 8N1, no flow control, high stop bit*/
+#endif
+
+  U0CSR = UCSR_MODE; /* UART mode */
+  U0UCR |= 0x80; /* Flush */
+  UART0_RX_EN();
+
+  UART0_RX_INT(1);
+#if UART0_RX_RING
+  process_start(&uart0_rx_process, NULL);
+#endif
+
+#if UART0_TX_DMA
+  tx_dma_init();
+#endif
+}
+/*---------------------------------------------------------------------------*/
+#if UART0_TX_DMA
+/*
+ * Queue one byte and return. Waits only when the ring is full, and drops
+ * the byte if the DMA ISR cannot make room (interrupts disabled).
+ */
+void
+uart0_writeb(uint8_t byte)
+{
+  uint8_t ea;
+
+  if(tx_dma < 0) {
+    while(!TX_IDLE());
+    UTX0IF = 0;
+    U0DBUF = byte;
+    return;
+  }
+
+  while((uint8_t)(tx_head - tx_tail) == UART0_TX_BUF) {
+    if(!EA) {
+      return;
+    }
+  }
+
+  tx_ring[tx_head & TX_MASK] = byte;
+
+  ea = EA;
+  EA = 0;
+  tx_head++;
+  if(tx_len == 0) {
+    /* The last byte of the previous run may still be going out */
+    while(!TX_IDLE());
+    UTX0IF = 0;
+    tx_next();
+    DMA_ARM_WAIT();
+    DMA_TRIGGER(tx_dma);
+  }
+  EA = ea;
+}
+/*---------------------------------------------------------------------------*/
+/* Wait until every queued byte is on the line */
+void
+uart0_flush(void)
+{
+  if(!EA) {
+    return;
+  }
+  while(tx_len != 0 || !TX_IDLE());
+}
+/*---------------------------------------------------------------------------*/
+uint8_t
+uart0_tx_idle(void)
+{
+  return tx_len == 0 && TX_IDLE();
+}
+#else
+/*---------------------------------------------------------------------------*/
+/* Write one byte over the UART. */
+void
+uart0_writeb(uint8_t byte)
+{
+  UTX0IF = 0;
+  U0DBUF = byte;
+  while(!UTX0IF); /* Wait until byte has been transmitted. */
+  UTX0IF = 0;
+}
+#endif /* UART0_TX_DMA */
+#endif
@@ -1,41 +1,79 @@
-#ifndef UART_0_H
-#define UART_0_H
-
-#include "contiki-conf.h"
-
-#include "cc1110.h"
-#include "8051def.h"
-#include "uart.h"
-
-/*---------------------------------------------------------------------------*/
-/* UART0 Enable - Disable */
-#ifdef UART0_CONF_ENABLE
-#define UART0_ENABLE UART0_CONF_ENABLE
-#else
-#define UART0_ENABLE 0
-#endif
-/*---------------------------------------------------------------------------*/
-/* UART0 Function Declarations */
-#if UART0_ENABLE
-void uart0_init();
-void uart0_writeb(uint8_t byte);
-
-void uart0_set_input(int (* input)(unsigned char c));
-
-#if UART0_CONF_WITH_INPUT
-void uart0_rx_isr(void) __interrupt(URX0_VECTOR);
-/* Macro to turn on / off UART RX Interrupt */
-#define UART0_RX_INT(v) do { URX0IE = v; } while(0)
-#define UART0_RX_EN()   do {   U0CSR |= UCSR_RE; } while(0)
-#else
-#define UART0_RX_INT(v)
-#define UART0_RX_EN()
-#endif /* UART0_CONF_WITH_INPUT */
-#else
-#define uart0_init(...)
-#define uart0_writeb(...)
-#define uart0_set_input(...)
-#define UART0_RX_INT(v)
-#define UART0_RX_EN()
-#endif /* UART0_ENABLE */
-#endif /* UART_0_H */
+#ifndef UART_0_H
+#define UART_0_H
+
+#include "contiki.h"
+
+#include "cc1110.h"
+#include "8051def.h"
+#include "uart.h"
+
+/*---------------------------------------------------------------------------*/
+/* UART0 Enable - Disable */
+#ifdef UART0_CONF_ENABLE
+#define UART0_ENABLE UART0_CONF_ENABLE
+#else
+#define UART0_ENABLE 0
+#endif
+
+/* Queue the output in an XDATA ring drained by DMA, instead of polling */
+#ifdef UART0_CONF_TX_DMA
+#define UART0_TX_DMA UART0_CONF_TX_DMA
+#else
+#define UART0_TX_DMA 0
+#endif
+
+/*
+ * Bytes the RX ISR can queue for uart0_rx_process, a power of 2 up to
+ * 128. The input handler then runs in the process, not in the ISR.
+ * 0 calls it from the ISR for every byte
+ */
+#if defined(UART0_CONF_RX_RING) && UART0_CONF_WITH_INPUT
+#define UART0_RX_RING UART0_CONF_RX_RING
+#else
+#define UART0_RX_RING 0
+#endif
+
+/* Size of the TX ring, a power of 2 up to 128 */
+#ifdef UART0_CONF_TX_BUF
+#define UART0_TX_BUF UART0_CONF_TX_BUF
+#else
+#define UART0_TX_BUF 128
+#endif
+/*---------------------------------------------------------------------------*/
+/* UART0 Function Declarations */
+#if UART0_ENABLE
+void uart0_init();
+void uart0_writeb(uint8_t byte);
+#if UART0_TX_DMA
+void uart0_flush(void);
+uint8_t uart0_tx_idle(void);
+#else
+#define uart0_flush()
+#define uart0_tx_idle() 1
+#endif
+
+void uart0_set_input(int (* input)(unsigned char c));
+
+#if UART0_RX_RING
+PROCESS_NAME(uart0_rx_process);
+#endif
+
+#if UART0_CONF_WITH_INPUT
+void uart0_rx_isr(void) __interrupt(URX0_VECTOR);
+/* Macro to turn on / off UART RX Interrupt */
+#define UART0_RX_INT(v) do { URX0IE = v; } while(0)
+#define UART0_RX_EN()   do {   U0CSR |= UCSR_RE; } while(0)
+#else
+#define UART0_RX_INT(v)
+#define UART0_RX_EN()
+#endif /* UART0_CONF_WITH_INPUT */
+#else
+#define uart0_init(...)
+#define uart0_writeb(...)
+#define uart0_flush()
+#define uart0_tx_idle() 1
+#define uart0_set_input(...)
+#define UART0_RX_INT(v)
+#define UART0_RX_EN()
+#endif /* UART0_ENABLE */
+#endif /* UART_0_H */
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         AES-CCM with M = 4 and L = 2, see ccm.h
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#include "net/ccm.h"
+#include "dev/aes.h"
+
+#include <string.h>
+
+/* CCM flags: B0 with M = 4 and L = 2, the counter blocks with L = 2 */
+#define FLAGS_B0  ((((CCM_MIC_LEN - 2) / 2) << 3) | (2 - 1))
+#define FLAGS_CTR (2 - 1)
+
+/* B0 or a counter block, and the CBC-MAC tag */
+static __xdata uint8_t blk[AES_BLOCK_LEN];
+static __xdata uint8_t tag[AES_BLOCK_LEN];
+/*---------------------------------------------------------------------------*/
+/* [flags][nonce][n, 16 bits]: the message length in B0, the index in A_i */
+static void
+block(uint8_t flags, const uint8_t *nonce, uint8_t n)
+{
+    blk[0] = flags;
+    memcpy(&blk[1], nonce, CCM_NONCE_LEN);
+    blk[14] = 0;
+    blk[15] = n;
+}
+/*---------------------------------------------------------------------------*/
+/* CBC-MAC of the plain text 'buf', encrypted with A_0 into tag */
+static void
+mic(const uint8_t *nonce, const uint8_t *buf, uint8_t len)
+{
+    block(FLAGS_B0, nonce, len);
+    aes_cbc_mac(blk, buf, len, tag);
+
+    block(FLAGS_CTR, nonce, 0);
+    aes_ctr(blk, tag, CCM_MIC_LEN);
+}
+/*---------------------------------------------------------------------------*/
+void
+ccm_seal(const uint8_t *nonce, uint8_t *buf, uint8_t len, uint8_t *m)
+{
+    mic(nonce, buf, len);
+
+    block(FLAGS_CTR, nonce, 1);
+    aes_ctr(blk, buf, len);
+
+    memcpy(m, tag, CCM_MIC_LEN);
+}
+/*---------------------------------------------------------------------------*/
+int
+ccm_open(const uint8_t *nonce, uint8_t *buf, uint8_t len, const uint8_t *m)
+{
+    uint8_t diff;
+    uint8_t i;
+
+    block(FLAGS_CTR, nonce, 1);
+    aes_ctr(blk, buf, len);
+
+    mic(nonce, buf, len);
+
+    // every byte, so the time does not tell how much of a forgery matched
+    diff = 0;
+    for(i = 0; i < CCM_MIC_LEN; i++)
+    {
+        diff |= tag[i] ^ m[i];
+    }
+    return diff == 0;
+}
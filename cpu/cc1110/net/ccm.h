@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         AES-CCM (RFC 3610) with M = 4, L = 2 and no additional
+ *         authenticated data, on top of the dev/aes.h calls: the link
+ *         layer core of net/link-crypt.c.
+ *
+ *         It only needs aes_set_key(), aes_ctr() and aes_cbc_mac(), so it
+ *         builds on the host as well, with a software AES behind them
+ *         (tools/cc1110).
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#ifndef CCM_H_
+#define CCM_H_
+
+#include "contiki.h"
+
+#define CCM_MIC_LEN   4  /* M */
+#define CCM_NONCE_LEN 13 /* 15 - L */
+
+/*
+ * Encrypt 'buf' in place and write its CCM_MIC_LEN bytes MIC to 'mic',
+ * with the key of the last aes_set_key(). 'len' up to 255 bytes.
+ */
+void ccm_seal(const uint8_t *nonce, uint8_t *buf, uint8_t len, uint8_t *mic);
+
+/* Decrypt 'buf' in place, 0 if 'mic' does not match */
+int ccm_open(const uint8_t *nonce, uint8_t *buf, uint8_t len,
+             const uint8_t *mic);
+
+#endif /* CCM_H_ */
@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Link layer AES-CCM, see link-crypt.h. The CCM itself is in ccm.c
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#include "net/link-crypt.h"
+#include "net/ccm.h"
+#include "net/packetbuf.h"
+#include "dev/aes.h"
+#include "dev/flash.h"
+
+#include <string.h>
+
+#if LINK_CRYPT_CONF_ENABLED
+
+#if !defined(FLASH_DATA_PAGES) || FLASH_DATA_PAGES < 2
+#error "link-crypt keeps its epoch in flash: set FLASH_DATA_PAGES = 2 in the Makefile"
+#endif
+
+/* IEEE 802.15.4 security level: ENC-MIC-32 */
+#define SEC_LEVEL 0x05
+
+/* Senders whose highest frame counter is remembered */
+#ifdef LINK_CRYPT_CONF_NEIGHBORS
+#define NEIGHBORS LINK_CRYPT_CONF_NEIGHBORS
+#else
+#define NEIGHBORS 8
+#endif
+
+/*
+ * Epoch log: the epochs in use, 16 bits each, one after the other in a
+ * flash page and in increasing order. When a page is full the other one
+ * is erased and takes the next epoch, so the highest epoch is always in
+ * flash even if the power fails during the erase.
+ */
+#define EPOCH_PAGE(i) (FLASH_DATA_START + (i) * FLASH_PAGE_SIZE)
+#define EPOCH_SLOTS   (FLASH_PAGE_SIZE / 2)
+#define EPOCH_NONE    0xFFFF /* an erased slot */
+
+struct neighbor {
+    rimeaddr_t addr;
+    uint32_t counter;
+};
+
+static __code const uint8_t key[AES_BLOCK_LEN] = LINK_CRYPT_CONF_KEY;
+
+/* Frame counter: the epoch in the upper 16 bits */
+static uint32_t counter;
+static uint16_t epoch;
+static uint8_t epoch_page;
+static uint16_t epoch_slot; /* the next free slot in epoch_page */
+static uint8_t ready; /* an epoch is saved */
+
+static struct neighbor neighbors[NEIGHBORS];
+static uint8_t neighbor_next;
+
+static __xdata uint8_t nonce_buf[CCM_NONCE_LEN];
+/*---------------------------------------------------------------------------*/
+/* [sender, zero padded to 8 bytes][frame counter][security level] */
+static void
+nonce(const rimeaddr_t *sender, const uint8_t *ctr)
+{
+    memset(nonce_buf, 0, 8);
+    memcpy(nonce_buf, sender, RIMEADDR_SIZE);
+    memcpy(&nonce_buf[8], ctr, LINK_CRYPT_COUNTER_LEN);
+    nonce_buf[12] = SEC_LEVEL;
+}
+/*---------------------------------------------------------------------------*/
+static uint16_t
+epoch_read(uint8_t page, uint16_t slot)
+{
+    uint16_t addr;
+
+    addr = EPOCH_PAGE(page) + slot * 2;
+    return FLASH_READ(addr) | (FLASH_READ(addr + 1) << 8);
+}
+/*---------------------------------------------------------------------------*/
+/*
+ * Take the next epoch and save it in flash before it is used: the frame
+ * counter starts again from it. 0 if the flash cannot be written or the
+ * epochs are over (a new key is due).
+ */
+static int
+epoch_next(void)
+{
+    static __xdata uint8_t buf[2];
+    uint16_t next;
+
+    // EPOCH_NONE + 1 is 0, the first epoch
+    next = epoch + 1;
+    if(next == EPOCH_NONE)
+    {
+        return 0;
+    }
+
+    // a slot that is not erased is left by an erase cut short: skip the page
+    if(epoch_slot == EPOCH_SLOTS || epoch_read(epoch_page, epoch_slot) != EPOCH_NONE)
+    {
+        epoch_page ^= 1;
+        epoch_slot = 0;
+        flash_erase(EPOCH_PAGE(epoch_page));
+    }
+
+    buf[0] = next;
+    buf[1] = next >> 8;
+    if(!flash_write(EPOCH_PAGE(epoch_page) + epoch_slot * 2, buf, 2))
+    {
+        return 0;
+    }
+    epoch_slot++;
+
+    epoch = next;
+    counter = (uint32_t)epoch << 16;
+    return 1;
+}
+/*---------------------------------------------------------------------------*/
+int
+link_crypt_init(void)
+{
+    uint8_t page;
+    uint16_t slot;
+    uint16_t e;
+
+    /*
+     * A node that reboots must not reuse its old nonces: go on from the
+     * highest epoch in flash, the last one written in one of the pages
+     */
+    epoch = EPOCH_NONE;
+    epoch_page = 1; // first boot: the first page takes epoch 0
+    epoch_slot = EPOCH_SLOTS;
+    for(page = 0; page < 2; page++)
+    {
+        for(slot = 0; slot < EPOCH_SLOTS
+                && (e = epoch_read(page, slot)) != EPOCH_NONE; slot++)
+        {
+            if(epoch == EPOCH_NONE || e > epoch)
+            {
+                epoch = e;
+                epoch_page = page;
+                epoch_slot = slot + 1;
+            }
+        }
+    }
+
+    ready = epoch_next();
+    return ready;
+}
+/*---------------------------------------------------------------------------*/
+/*
+ * Frame counter check: the counter of a sender only goes up, an older
+ * frame is a replay. Unknown senders replace the oldest entry.
+ */
+static struct neighbor *
+neighbor_find(const rimeaddr_t *sender)
+{
+    uint8_t i;
+
+    for(i = 0; i < NEIGHBORS; i++)
+    {
+        if(rimeaddr_cmp(&neighbors[i].addr, sender))
+        {
+            return &neighbors[i];
+        }
+    }
+    return NULL;
+}
+/*---------------------------------------------------------------------------*/
+int
+link_crypt_seal(void)
+{
+    uint8_t *ctr;
+    uint8_t *buf;
+    uint8_t len;
+
+    if(!ready || packetbuf_totlen() + LINK_CRYPT_OVERHEAD > PACKETBUF_SIZE)
+    {
+        return 0;
+    }
+
+    // the low 16 bits are over: on to the next epoch
+    if((uint16_t)counter == 0xFFFF && !epoch_next())
+    {
+        return 0;
+    }
+
+    if(!packetbuf_hdralloc(LINK_CRYPT_COUNTER_LEN))
+    {
+        return 0;
+    }
+
+    counter++;
+    ctr = packetbuf_hdrptr();
+    ctr[0] = counter >> 24;
+    ctr[1] = counter >> 16;
+    ctr[2] = counter >> 8;
+    ctr[3] = counter;
+
+    buf = ctr + LINK_CRYPT_COUNTER_LEN;
+    len = packetbuf_totlen() - LINK_CRYPT_COUNTER_LEN;
+
+    // the coprocessor loses the key in PM2, load it for every frame
+    aes_set_key(key);
+    nonce(&rimeaddr_node_addr, ctr);
+    ccm_seal(nonce_buf, buf, len, buf + len);
+
+    packetbuf_set_datalen(packetbuf_datalen() + LINK_CRYPT_MIC_LEN);
+
+    return 1;
+}
+/*---------------------------------------------------------------------------*/
+int
+link_crypt_open(const rimeaddr_t *sender)
+{
+    struct neighbor *n;
+    uint8_t *ctr;
+    uint8_t *buf;
+    uint8_t len;
+    uint32_t c;
+
+    if(packetbuf_datalen() <= LINK_CRYPT_OVERHEAD)
+    {
+        return 0;
+    }
+
+    ctr = packetbuf_dataptr();
+    buf = ctr + LINK_CRYPT_COUNTER_LEN;
+    len = packetbuf_datalen() - LINK_CRYPT_OVERHEAD;
+
+    c = ((uint32_t)ctr[0] << 24) | ((uint32_t)ctr[1] << 16)
+        | ((uint16_t)ctr[2] << 8) | ctr[3];
+    n = neighbor_find(sender);
+    if(n != NULL && c <= n->counter)
+    {
+        return 0;
+    }
+
+    aes_set_key(key);
+    nonce(sender, ctr);
+    if(!ccm_open(nonce_buf, buf, len, buf + len))
+    {
+        return 0;
+    }
+
+    // only an authentic frame moves the counter of its sender
+    if(n == NULL)
+    {
+        n = &neighbors[neighbor_next];
+        neighbor_next = (neighbor_next + 1) % NEIGHBORS;
+        rimeaddr_copy(&n->addr, sender);
+    }
+    n->counter = c;
+
+    packetbuf_hdrreduce(LINK_CRYPT_COUNTER_LEN);
+    packetbuf_set_datalen(len);
+
+    return 1;
+}
+/*---------------------------------------------------------------------------*/
+#endif /* LINK_CRYPT_CONF_ENABLED */
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Link layer encryption and authentication, AES-CCM on the cc1110
+ *         coprocessor.
+ *
+ *         A sealed frame is [frame counter][ciphertext][MIC]: the counter
+ *         is big endian, the MIC is LINK_CRYPT_MIC_LEN bytes. The CCM nonce
+ *         is [sender, zero padded to 8 bytes][frame counter][0x05], the
+ *         IEEE 802.15.4 layout with security level ENC-MIC-32, and there is
+ *         no additional authenticated data: any AES-CCM implementation with
+ *         M = 4 and L = 2 opens the frames given the key.
+ *
+ *         The frame counter never repeats for a key: its upper 16 bits are
+ *         an epoch, saved in flash at every boot and every 65535 frames
+ *         (the project needs FLASH_DATA_PAGES = 2, see Makefile.cc1110).
+ *         The receiver keeps the highest counter of the last
+ *         LINK_CRYPT_CONF_NEIGHBORS senders and drops the frames that do
+ *         not go above it, so a frame cannot be replayed unless its sender
+ *         has been pushed out of the table.
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#ifndef LINK_CRYPT_H_
+#define LINK_CRYPT_H_
+
+#include "contiki.h"
+#include "net/rime/rimeaddr.h"
+#include "net/ccm.h"
+
+#define LINK_CRYPT_COUNTER_LEN 4
+#define LINK_CRYPT_MIC_LEN     CCM_MIC_LEN
+
+/* Bytes a sealed frame takes more than the plain one */
+#define LINK_CRYPT_OVERHEAD (LINK_CRYPT_COUNTER_LEN + LINK_CRYPT_MIC_LEN)
+
+/*
+ * After netstack_init(). 0 if no epoch could be saved in flash: every
+ * link_crypt_seal() fails then, and nothing is sent
+ */
+int link_crypt_init(void);
+
+/*
+ * Encrypt the whole packetbuf frame (header included) and append the MIC,
+ * 0 if it does not fit or no epoch could be saved
+ */
+int link_crypt_seal(void);
+
+/*
+ * Check the MIC of a frame from 'sender' and decrypt it in place,
+ * 0 if the frame is not authentic or is a replay
+ */
+int link_crypt_open(const rimeaddr_t *sender);
+
+#endif /* LINK_CRYPT_H_ */
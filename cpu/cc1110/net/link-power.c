@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Per neighbor transmit power selection, see link-power.h
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#include "link-power.h"
+
+#include <string.h>
+
+/* Correlation worse than this (CC1101 LQI, lower is better): one level more */
+#define LQI_BAD 40
+
+struct link {
+    rimeaddr_t addr;
+    uint8_t loss;  /* path loss in dB, smoothed */
+    uint8_t level;
+};
+
+/* Most recently heard first */
+static struct link links[LINK_POWER_NEIGHBORS];
+static uint8_t used;
+
+const int8_t link_power_dbm[LINK_POWER_LEVELS] = { -20, -10, -5, 0, 7 };
+/*---------------------------------------------------------------------------*/
+void
+link_power_update(const rimeaddr_t *from, int8_t tx_dbm, int8_t rssi,
+                  uint8_t lqi)
+{
+    struct link l;
+    int16_t loss;
+    uint8_t i;
+
+    loss = tx_dbm - rssi;
+    if(loss < 0)
+    {
+        loss = 0;
+    }
+    else if(loss > 255)
+    {
+        loss = 255;
+    }
+
+    for(i = 0; i < used; i++)
+    {
+        if(rimeaddr_cmp(&links[i].addr, from))
+        {
+            break;
+        }
+    }
+
+    if(i < used)
+    {
+        // smooth out the fading
+        l = links[i];
+        l.loss = (3 * (uint16_t)l.loss + loss) / 4;
+    }
+    else
+    {
+        if(used < LINK_POWER_NEIGHBORS)
+        {
+            used++;
+        }
+        // a new neighbor takes the place of the least recently heard one
+        i = used - 1;
+        rimeaddr_copy(&l.addr, from);
+        l.loss = loss;
+    }
+
+    for(l.level = 0; l.level < LINK_POWER_LEVELS - 1; l.level++)
+    {
+        if(link_power_dbm[l.level] - l.loss >= LINK_POWER_TARGET)
+        {
+            break;
+        }
+    }
+    if(lqi > LQI_BAD && l.level < LINK_POWER_LEVELS - 1)
+    {
+        l.level++;
+    }
+
+    memmove(&links[1], &links[0], i * sizeof(struct link));
+    links[0] = l;
+}
+/*---------------------------------------------------------------------------*/
+uint8_t
+link_power_level(const rimeaddr_t *to)
+{
+    uint8_t i;
+
+    if(!rimeaddr_cmp(to, &rimeaddr_null))
+    {
+        for(i = 0; i < used; i++)
+        {
+            if(rimeaddr_cmp(&links[i].addr, to))
+            {
+                return links[i].level;
+            }
+        }
+    }
+
+    return LINK_POWER_DEFAULT;
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Per neighbor transmit power selection.
+ *
+ *         Every frame carries the power it was sent with, so the receiver
+ *         knows the path loss of the link: the next frames to that
+ *         neighbor use the lowest level that still arrives
+ *         LINK_POWER_TARGET dBm strong. Plain C, the native simulation in
+ *         apps/txpower-sim builds it too.
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#ifndef LINK_POWER_H_
+#define LINK_POWER_H_
+
+#include "contiki.h"
+#include "net/rime/rimeaddr.h"
+
+/* Levels, weakest first. The radio maps them to PA_TABLE0 values */
+#define LINK_POWER_LEVELS   5
+
+/* Broadcast and unknown neighbors: -5 dBm, the historical setting */
+#define LINK_POWER_DEFAULT  2
+
+/* Signal wanted at the receiver: sensitivity at 38.4k plus an 8 dB fading margin */
+#ifdef LINK_POWER_CONF_TARGET
+#define LINK_POWER_TARGET LINK_POWER_CONF_TARGET
+#else
+#define LINK_POWER_TARGET -95
+#endif
+
+/* Neighbors tracked, the least recently heard one is replaced */
+#ifdef LINK_POWER_CONF_NEIGHBORS
+#define LINK_POWER_NEIGHBORS LINK_POWER_CONF_NEIGHBORS
+#else
+#define LINK_POWER_NEIGHBORS 8
+#endif
+
+/* Output power of every level, in dBm */
+extern const int8_t link_power_dbm[LINK_POWER_LEVELS];
+
+/*
+ * A frame from 'from' sent at 'tx_dbm' arrived with 'rssi' dBm and
+ * correlation 'lqi' (CC1101 LQI, the lower the better)
+ */
+void link_power_update(const rimeaddr_t *from, int8_t tx_dbm, int8_t rssi,
+                       uint8_t lqi);
+
+/* Level to use for a frame to 'to', LINK_POWER_DEFAULT for broadcast */
+uint8_t link_power_level(const rimeaddr_t *to);
+
+#endif /* LINK_POWER_H_ */
@@ -0,0 +1,408 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Low power listening RDC driver for the cc1110.
+ *
+ *         The listen schedule is kept in software, the hardware Wake-on-Radio
+ *         (WOREVT1, MCSM2.RX_TIME) is not used: a ctimer turns the radio on
+ *         CHECK_RATE times a second, an rtimer keeps it in RX for
+ *         LISTEN_TIME and turns it off again if the channel is clear. The sender repeats (strobes) the
+ *         frame for a whole check interval, so every receiver catches at
+ *         least one copy; a [seqno][sender] header lets the receiver drop
+ *         the other copies.
+ *
+ *         No acks: unicast and broadcast frames are strobed the same way.
+ *         The strobes need CC1101_RF_CONF_TX_ASYNC.
+ *
+ *         With LINK_CRYPT_CONF_ENABLED the frame is sealed once, before the
+ *         header, and every strobe is a copy of the same ciphertext. The
+ *         TX power byte of CC1101_RF_CONF_TX_POWER is sealed with the frame.
+ *
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#include "contiki.h"
+#include "net/listen-rdc.h"
+#include "net/mac/mac.h"
+#include "net/netstack.h"
+#include "net/packetbuf.h"
+#include "net/queuebuf.h"
+#include "net/rime/rimeaddr.h"
+#include "net/rime/rimestats.h"
+#include "sys/ctimer.h"
+#include "sys/rtimer.h"
+#include "dev/radio.h"
+#include "dev/cc1101-rf.h"
+#if CC1101_RF_CONF_TX_POWER
+#include "net/link-power.h"
+#endif
+#if LINK_CRYPT_CONF_ENABLED
+#include "net/link-crypt.h"
+#endif
+
+#include <string.h>
+
+#if !CC1101_RF_CONF_TX_ASYNC
+#error "listen_rdc_driver strobes with CC1101_RF_CONF_TX_ASYNC"
+#endif
+
+/*---------------------------------------------------------------------------*/
+/* Channel checks per second, the same on every node of the network */
+#ifdef LISTEN_RDC_CONF_CHECK_RATE
+#define CHECK_RATE LISTEN_RDC_CONF_CHECK_RATE
+#else
+#define CHECK_RATE 4
+#endif
+
+/*
+ * Keep the radio of this node always in RX (i.e. a mains powered
+ * gateway): it still strobes, so the other nodes get its frames
+ */
+#ifdef LISTEN_RDC_CONF_ALWAYS_ON
+#define ALWAYS_ON LISTEN_RDC_CONF_ALWAYS_ON
+#else
+#define ALWAYS_ON 0
+#endif
+
+#define CHECK_INTERVAL (CLOCK_SECOND / CHECK_RATE)
+
+/*
+ * RX window of a check. The radio sends the strobes back to back from its
+ * RF ISR (cc1101_rf_set_repeat()), so two strobes are apart by the RX to
+ * TX turnaround plus the ISR latency, some tens of us whatever the main
+ * loop is doing. The window covers that gap and the RSSI settling time
+ * after the radio enters RX; profiles slower than 38.4k settle slower and
+ * need a longer window.
+ */
+#ifdef LISTEN_RDC_CONF_LISTEN_TIME
+#define LISTEN_TIME LISTEN_RDC_CONF_LISTEN_TIME
+#else
+#define LISTEN_TIME (RTIMER_ARCH_SECOND / 500)
+#endif
+
+/* The strobes cover a whole check interval and one more RX window */
+#define STROBE_TIME    (RTIMER_ARCH_SECOND / CHECK_RATE + LISTEN_TIME)
+
+/* Windows to wait for a frame once the channel is busy */
+#define LISTEN_MAX 24
+
+#define HDR_LEN (1 + RIMEADDR_SIZE) /* seqno, sender */
+
+#if CC1101_RF_CONF_TX_POWER
+/* TX power in dBm, after the header: the receiver learns the path loss */
+#define PWR_LEN 1
+#else
+#define PWR_LEN 0
+#endif
+
+#if LINK_CRYPT_CONF_ENABLED
+/* frame counter, in front of the TX power byte */
+#define CRYPT_LEN LINK_CRYPT_COUNTER_LEN
+#else
+#define CRYPT_LEN 0
+#endif
+
+/* Last frames received, to drop the other strobes */
+#define SEEN_SLOTS 4
+/*---------------------------------------------------------------------------*/
+#define DEBUG 0
+#if DEBUG
+#include <stdio.h>
+#define PRINTF(...) printf(__VA_ARGS__)
+#else
+#define PRINTF(...)
+#endif
+/*---------------------------------------------------------------------------*/
+struct seen {
+    rimeaddr_t sender;
+    uint8_t seqno;
+};
+
+static struct seen seen[SEEN_SLOTS];
+static uint8_t seen_next;
+
+static uint8_t seqno;
+static uint8_t is_on; /* the upper layer wants the radio on */
+
+#if !ALWAYS_ON
+static struct ctimer check_ctimer;
+static struct rtimer listen_rtimer;
+static uint8_t listen_count;
+#endif
+static volatile uint8_t listening;
+
+static volatile uint8_t strobing;
+static mac_callback_t strobe_sent;
+static void *strobe_ptr;
+/*---------------------------------------------------------------------------*/
+/* Switch the radio off unless somebody still needs it */
+static void
+radio_idle(void)
+{
+    if(!is_on && !strobing && !listening)
+    {
+        NETSTACK_RADIO.off();
+    }
+}
+/*---------------------------------------------------------------------------*/
+#if !ALWAYS_ON
+/*
+ * rtimer ISR: stay in RX while the channel is busy, up to LISTEN_MAX
+ * windows, otherwise back to sleep.
+ */
+static void
+listen_check(struct rtimer *t, void *ptr)
+{
+    if(!listening)
+    {
+        return;
+    }
+
+    if((!NETSTACK_RADIO.channel_clear() || NETSTACK_RADIO.receiving_packet())
+            && ++listen_count < LISTEN_MAX)
+    {
+        rtimer_set(t, RTIMER_NOW() + LISTEN_TIME, 1, listen_check, NULL);
+        return;
+    }
+
+    listening = 0;
+    radio_idle();
+}
+/*---------------------------------------------------------------------------*/
+static void
+check(void *ptr)
+{
+    ctimer_reset(&check_ctimer);
+
+    if(is_on || strobing || listening)
+    {
+        return;
+    }
+
+    listening = 1;
+    listen_count = 0;
+    NETSTACK_RADIO.on();
+    rtimer_set(&listen_rtimer, RTIMER_NOW() + LISTEN_TIME, 1, listen_check, NULL);
+}
+#endif
+/*---------------------------------------------------------------------------*/
+/* Radio TX callback: the strobe train is over, report the outcome */
+static void
+strobe_done(int status)
+{
+    int ret;
+
+    if(!strobing)
+    {
+        return;
+    }
+
+    strobing = 0;
+    radio_idle();
+
+    if(status == RADIO_TX_OK)
+    {
+        ret = MAC_TX_OK;
+    }
+    else if(status == RADIO_TX_COLLISION)
+    {
+        ret = MAC_TX_COLLISION;
+    }
+    else
+    {
+        ret = MAC_TX_ERR;
+    }
+
+    PRINTF("listen-rdc: %d strobes, %d\n", cc1101_rf_tx_count(), ret);
+    mac_call_sent_callback(strobe_sent, strobe_ptr, ret, cc1101_rf_tx_count());
+}
+/*---------------------------------------------------------------------------*/
+static void
+send_packet(mac_callback_t sent, void *ptr)
+{
+    uint8_t *hdr;
+
+    if(strobing)
+    {
+        mac_call_sent_callback(sent, ptr, MAC_TX_COLLISION, 0);
+        return;
+    }
+
+#if CC1101_RF_CONF_TX_POWER
+    if(!packetbuf_hdralloc(PWR_LEN))
+    {
+        mac_call_sent_callback(sent, ptr, MAC_TX_ERR_FATAL, 0);
+        return;
+    }
+    // the same level the radio picks for this frame
+    *(uint8_t *)packetbuf_hdrptr() =
+        link_power_dbm[link_power_level(packetbuf_addr(PACKETBUF_ADDR_RECEIVER))];
+#endif
+
+#if LINK_CRYPT_CONF_ENABLED
+    if(!link_crypt_seal())
+    {
+        packetbuf_hdr_remove(PWR_LEN);
+        mac_call_sent_callback(sent, ptr, MAC_TX_ERR_FATAL, 0);
+        return;
+    }
+#endif
+
+    if(!packetbuf_hdralloc(HDR_LEN))
+    {
+        packetbuf_hdr_remove(CRYPT_LEN + PWR_LEN);
+        mac_call_sent_callback(sent, ptr, MAC_TX_ERR_FATAL, 0);
+        return;
+    }
+
+    hdr = packetbuf_hdrptr();
+    hdr[0] = ++seqno;
+    memcpy(hdr + 1, &rimeaddr_node_addr, RIMEADDR_SIZE);
+
+    strobing = 1;
+    listening = 0;
+    strobe_sent = sent;
+    strobe_ptr = ptr;
+
+    // stay in RX between the strobes, so they skip the radio turn on
+    NETSTACK_RADIO.on();
+
+    // the radio repeats its own copy of the frame
+    cc1101_rf_set_repeat(STROBE_TIME);
+    if(NETSTACK_RADIO.send(packetbuf_hdrptr(), packetbuf_totlen()) != RADIO_TX_OK)
+    {
+        strobing = 0;
+        radio_idle();
+        mac_call_sent_callback(sent, ptr, MAC_TX_ERR, 1);
+    }
+
+    packetbuf_hdr_remove(HDR_LEN + CRYPT_LEN + PWR_LEN);
+}
+/*---------------------------------------------------------------------------*/
+static void
+send_list(mac_callback_t sent, void *ptr, struct rdc_buf_list *buf_list)
+{
+    if(buf_list != NULL)
+    {
+        queuebuf_to_packetbuf(buf_list->buf);
+        send_packet(sent, ptr);
+    }
+}
+/*---------------------------------------------------------------------------*/
+static void
+packet_input(void)
+{
+    uint8_t *hdr;
+    uint8_t i;
+    rimeaddr_t sender;
+
+    if(packetbuf_datalen() <= HDR_LEN + PWR_LEN)
+    {
+        RIMESTATS_ADD(tooshort);
+        return;
+    }
+
+    hdr = packetbuf_dataptr();
+    memcpy(&sender, hdr + 1, RIMEADDR_SIZE);
+
+    for(i = 0; i < SEEN_SLOTS; i++)
+    {
+        if(seen[i].seqno == hdr[0]
+                && memcmp(&seen[i].sender, hdr + 1, RIMEADDR_SIZE) == 0)
+        {
+            PRINTF("listen-rdc: drop duplicate %d\n", hdr[0]);
+            return;
+        }
+    }
+
+    packetbuf_hdrreduce(HDR_LEN);
+
+#if LINK_CRYPT_CONF_ENABLED
+    // a forged frame must not hide the real one with the same seqno
+    if(!link_crypt_open(&sender))
+    {
+        PRINTF("listen-rdc: bad MIC from %d.%d\n", sender.u8[0], sender.u8[1]);
+        RIMESTATS_ADD(badmic);
+        return;
+    }
+#endif
+
+#if CC1101_RF_CONF_TX_POWER
+    // a path loss sample from the first authentic copy only
+    link_power_update(&sender, *(int8_t *)packetbuf_dataptr(),
+                      (int8_t)packetbuf_attr(PACKETBUF_ATTR_RSSI),
+                      packetbuf_attr(PACKETBUF_ATTR_LINK_QUALITY));
+    packetbuf_hdrreduce(PWR_LEN);
+#endif
+
+    seen[seen_next].seqno = hdr[0];
+    memcpy(&seen[seen_next].sender, hdr + 1, RIMEADDR_SIZE);
+    seen_next = (seen_next + 1) % SEEN_SLOTS;
+
+    // rime does not carry the sender of broadcast frames, we do
+    packetbuf_set_addr(PACKETBUF_ADDR_SENDER, &sender);
+
+    // got it, the remaining strobes are not for us
+    if(listening)
+    {
+        listening = 0;
+        radio_idle();
+    }
+
+    NETSTACK_MAC.input();
+}
+/*---------------------------------------------------------------------------*/
+static int
+on(void)
+{
+    is_on = 1;
+    return NETSTACK_RADIO.on();
+}
+/*---------------------------------------------------------------------------*/
+static int
+off(int keep_radio_on)
+{
+    is_on = keep_radio_on;
+    radio_idle();
+    return 1;
+}
+/*---------------------------------------------------------------------------*/
+static unsigned short
+channel_check_interval(void)
+{
+#if ALWAYS_ON
+    return 0;
+#else
+    return CHECK_INTERVAL;
+#endif
+}
+/*---------------------------------------------------------------------------*/
+static void
+init(void)
+{
+    cc1101_rf_set_tx_callback(strobe_done);
+
+#if ALWAYS_ON
+    on();
+#else
+    ctimer_set(&check_ctimer, CHECK_INTERVAL, check, NULL);
+#endif
+}
+/*---------------------------------------------------------------------------*/
+const struct rdc_driver listen_rdc_driver =
+{
+    "listen-rdc",
+    init,
+    send_packet,
+    send_list,
+    packet_input,
+    on,
+    off,
+    channel_check_interval,
+};
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Low power listening RDC driver for the cc1110, with a software
+ *         listen schedule (no hardware Wake-on-Radio)
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#ifndef LISTEN_RDC_H_
+#define LISTEN_RDC_H_
+
+#include "net/mac/rdc.h"
+
+extern const struct rdc_driver listen_rdc_driver;
+
+#endif /* LISTEN_RDC_H_ */
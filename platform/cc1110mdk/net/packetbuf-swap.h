@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Swappable packetbuf storage, an extension of the packetbuf of
+ *         this platform (packetbuf.c) for the zero-copy radio receive
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#ifndef PACKETBUF_SWAP_H_
+#define PACKETBUF_SWAP_H_
+
+#include "net/packetbuf.h"
+
+/* Bytes of a storage area that packetbuf_swap() accepts */
+#define PACKETBUF_STORAGE_SIZE (PACKETBUF_SIZE + PACKETBUF_HDR_SIZE)
+
+/*
+ * Replace the packetbuf storage with buf, a PACKETBUF_STORAGE_SIZE bytes
+ * area that already holds a frame at PACKETBUF_HDR_SIZE, and return the
+ * old storage to the caller. The packetbuf is cleared: set the frame
+ * length with packetbuf_set_datalen().
+ */
+uint8_t *packetbuf_swap(uint8_t *buf);
+
+#endif /* PACKETBUF_SWAP_H_ */
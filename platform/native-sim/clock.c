@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Virtual clock of the simulation, see sim.h
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+
+#include "sys/clock.h"
+#include "sim.h"
+
+/*---------------------------------------------------------------------------*/
+clock_time_t
+clock_time(void)
+{
+  return sim->now / (1000000 / CLOCK_SECOND);
+}
+/*---------------------------------------------------------------------------*/
+unsigned long
+clock_seconds(void)
+{
+  return sim->now / 1000000;
+}
+/*---------------------------------------------------------------------------*/
+void
+clock_delay(unsigned int d)
+{
+  /* Virtual time only moves between the events. */
+}
+/*---------------------------------------------------------------------------*/
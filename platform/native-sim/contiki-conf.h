@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         The native configuration, with the radio of the simulation
+ */
+#ifndef NATIVE_SIM_CONTIKI_CONF_H_
+#define NATIVE_SIM_CONTIKI_CONF_H_
+
+#define NETSTACK_CONF_RADIO   sim_radio_driver
+
+#include "../native/contiki-conf.h"
+
+#endif /* NATIVE_SIM_CONTIKI_CONF_H_ */
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Random numbers of the simulation, in place of the core one that
+ *         calls srand() and rand(): the libc state is outside the node
+ *         images, so every node drew from one shared sequence and the seed
+ *         of a node meant nothing. Here the state of a node is a static,
+ *         part of its image.
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+
+#include "lib/random.h"
+#include "sim.h"
+
+static uint32_t state;
+/*---------------------------------------------------------------------------*/
+/* Linear congruential, the upper half: same run on every host */
+uint16_t
+sim_random(uint32_t *s)
+{
+  *s = *s * 1664525UL + 1013904223UL;
+  return *s >> 16;
+}
+/*---------------------------------------------------------------------------*/
+void
+random_init(unsigned short seed)
+{
+  state = seed;
+}
+/*---------------------------------------------------------------------------*/
+unsigned short
+random_rand(void)
+{
+  return sim_random(&state);
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         rtimers on virtual time: the next one of a node is a wake up
+ *         event of the scheduler, see sim-main.c
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#include "contiki.h"
+#include "sys/rtimer.h"
+#include "sim.h"
+
+/*---------------------------------------------------------------------------*/
+void
+rtimer_arch_init(void)
+{
+  sim_node()->rtimer = SIM_NEVER;
+}
+/*---------------------------------------------------------------------------*/
+rtimer_clock_t
+rtimer_arch_now(void)
+{
+  return sim->now * RTIMER_ARCH_SECOND / 1000000;
+}
+/*---------------------------------------------------------------------------*/
+void
+rtimer_arch_schedule(rtimer_clock_t t)
+{
+  short ticks = (short)(t - rtimer_arch_now());
+
+  /* round up, the callback must not find its time still ahead */
+  sim_node()->rtimer = sim->now + (ticks > 0 ?
+    ((uint64_t)ticks * 1000000 + RTIMER_ARCH_SECOND - 1) / RTIMER_ARCH_SECOND : 0);
+}
+/*---------------------------------------------------------------------------*/
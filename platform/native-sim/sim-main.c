@@ -0,0 +1,469 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Discrete event scheduler of the native-sim platform, see sim.h
+ *
+ *         The nodes sit on a square grid, one step apart, and hear the
+ *         ones within -r steps. RSSI is -50 dBm at one step and drops by
+ *         6 dB every step more. The medium has the same rules as
+ *         tools/medium: airtime, half duplex, collisions with capture and
+ *         random loss.
+ *
+ *         usage: app.native-sim [-n nodes] [-T seconds] [-r range]
+ *                               [-b bit/s] [-l loss %] [-c capture dB]
+ *                               [-S seed] [-- app args]
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "contiki.h"
+#include "sys/rtimer.h"
+#include "net/netstack.h"
+#include "net/rime.h"
+#include "lib/random.h"
+
+#include "dev/button-sensor.h"
+#include "dev/pir-sensor.h"
+#include "dev/vib-sensor.h"
+
+#include "sim.h"
+
+/* preamble, sync word, length and crc of the CC1101 packet engine */
+#define PHY_OVERHEAD  (4 + 4 + 1 + 2)
+
+#define RSSI_ONE_STEP -50
+#define RSSI_PER_STEP 6
+
+#define US_PER_TICK   (1000000 / CLOCK_SECOND)
+
+struct sim_air_rx {
+  int node;
+  int8_t rssi;
+  uint8_t ok;
+};
+
+struct sim_air {
+  struct sim_air *next;
+  uint64_t end;
+  uint8_t len;
+  uint8_t frame[127];
+  int nrx;
+  struct sim_air_rx rx[];
+};
+
+/* Bounds of the node images, from the linker */
+extern char __data_start[], _end[];
+#define IMAGE_BASE __data_start
+#define IMAGE_SIZE ((size_t)(_end - __data_start))
+
+/* The compiler must not keep a variable of the old image in a register */
+#define IMAGE_BARRIER() __asm__ __volatile__("" ::: "memory")
+
+/* Same value in every image: set before the first copy */
+struct sim *sim;
+
+SENSORS(&pir_sensor, &vib_sensor, &button_sensor);
+
+int contiki_argc = 0;
+char **contiki_argv;
+/*---------------------------------------------------------------------------*/
+/* Put the image of node i in place */
+static void
+node_load(int i)
+{
+  if(sim->cur == i) {
+    return;
+  }
+  if(sim->cur >= 0) {
+    memcpy(sim->nodes[sim->cur].image, IMAGE_BASE, IMAGE_SIZE);
+  }
+  memcpy(IMAGE_BASE, sim->nodes[i].image, IMAGE_SIZE);
+  IMAGE_BARRIER();
+  sim->cur = i;
+}
+/*---------------------------------------------------------------------------*/
+static void
+heap_swap(int a, int b)
+{
+  int t = sim->heap[a];
+
+  sim->heap[a] = sim->heap[b];
+  sim->heap[b] = t;
+  sim->nodes[sim->heap[a]].pos = a;
+  sim->nodes[sim->heap[b]].pos = b;
+}
+/*---------------------------------------------------------------------------*/
+#define WAKE(p) (sim->nodes[sim->heap[p]].wake)
+
+static void
+heap_update(int i, uint64_t wake)
+{
+  int p = sim->nodes[i].pos;
+  int c;
+
+  sim->nodes[i].wake = wake;
+
+  while(p > 0 && WAKE((p - 1) / 2) > WAKE(p)) {
+    heap_swap(p, (p - 1) / 2);
+    p = (p - 1) / 2;
+  }
+  while((c = 2 * p + 1) < sim->n) {
+    if(c + 1 < sim->n && WAKE(c + 1) < WAKE(c)) {
+      c++;
+    }
+    if(WAKE(p) <= WAKE(c)) {
+      break;
+    }
+    heap_swap(p, c);
+    p = c;
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Run the node in place until it has nothing left to do */
+static void
+node_run(void)
+{
+  struct sim_node *n = sim_node();
+  uint64_t wake = SIM_NEVER;
+
+  if(n->rtimer <= sim->now) {
+    n->rtimer = SIM_NEVER;
+    rtimer_run_next();
+  }
+
+  etimer_request_poll();
+  while(process_run() > 0);
+
+  if(etimer_pending()) {
+    wake = (uint64_t)etimer_next_expiration_time() * US_PER_TICK;
+    if(wake < sim->now) {
+      wake = sim->now;
+    }
+  }
+  if(n->rtimer < wake) {
+    wake = n->rtimer;
+  }
+  heap_update(sim->cur, wake);
+}
+/*---------------------------------------------------------------------------*/
+static void
+node_boot(int i, const uint8_t *pristine, int seed)
+{
+  rimeaddr_t addr;
+
+  memcpy(IMAGE_BASE, pristine, IMAGE_SIZE);
+  IMAGE_BARRIER();
+  sim->cur = i;
+  random_init(seed + i);
+
+  process_init();
+  process_start(&etimer_process, NULL);
+  ctimer_init();
+  rtimer_init();
+
+  memset(&addr, 0, sizeof(rimeaddr_t));
+  addr.u8[0] = (i + 1) & 0xff;
+  addr.u8[1] = (i + 1) >> 8;
+  rimeaddr_set_node_addr(&addr);
+
+  queuebuf_init();
+  netstack_init();
+  autostart_start(autostart_processes);
+
+  node_run();
+  memcpy(sim->nodes[i].image, IMAGE_BASE, IMAGE_SIZE);
+}
+/*---------------------------------------------------------------------------*/
+static int
+isqrt(int v)
+{
+  int r = 0;
+
+  while((r + 1) * (r + 1) <= v) {
+    r++;
+  }
+  return r;
+}
+/*---------------------------------------------------------------------------*/
+/* The nodes within range steps of each other on the grid */
+static void
+topology_grid(int range)
+{
+  struct sim_node *n;
+  int side, i, x, y, dx, dy, j;
+
+  for(side = 1; side * side < sim->n; side++);
+
+  for(i = 0; i < sim->n; i++) {
+    n = &sim->nodes[i];
+    n->nbrs = malloc((2 * range + 1) * (2 * range + 1) * sizeof(int));
+    n->nbr_rssi = malloc((2 * range + 1) * (2 * range + 1));
+    x = i % side;
+    y = i / side;
+    for(dy = -range; dy <= range; dy++) {
+      for(dx = -range; dx <= range; dx++) {
+        j = (y + dy) * side + x + dx;
+        if((dx == 0 && dy == 0) || x + dx < 0 || x + dx >= side ||
+           y + dy < 0 || j >= sim->n || dx * dx + dy * dy > range * range) {
+          continue;
+        }
+        n->nbrs[n->nnbrs] = j;
+        n->nbr_rssi[n->nnbrs] = RSSI_ONE_STEP -
+          RSSI_PER_STEP * (isqrt(100 * (dx * dx + dy * dy)) - 10) / 10;
+        n->nnbrs++;
+      }
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+sim_air_start(const uint8_t *frame, uint8_t len)
+{
+  struct sim_node *s = sim_node();
+  struct sim_node *r;
+  struct sim_air *a, *c, **p;
+  struct sim_air_rx *rx;
+  uint64_t start;
+  int i, k;
+
+  a = malloc(sizeof(struct sim_air) + s->nnbrs * sizeof(struct sim_air_rx));
+  if(a == NULL || len > sizeof(a->frame)) {
+    free(a);
+    return;
+  }
+
+  /* back to back frames of a node go out one after the other */
+  start = s->tx_end > sim->now ? s->tx_end : sim->now;
+  a->end = start + (uint64_t)(len + PHY_OVERHEAD) * 8 * 1000000 / sim->bitrate;
+  a->len = len;
+  memcpy(a->frame, frame, len);
+  a->nrx = s->nnbrs;
+  sim->tx++;
+
+  /* half duplex: the frame the sender was receiving is gone */
+  if(s->current != NULL) {
+    for(k = 0; s->current->rx[k].node != sim->cur; k++);
+    s->current->rx[k].ok = 0;
+    s->current = NULL;
+  }
+  s->tx_end = a->end;
+
+  for(i = 0; i < s->nnbrs; i++) {
+    rx = &a->rx[i];
+    rx->node = s->nbrs[i];
+    rx->rssi = s->nbr_rssi[i];
+    rx->ok = 1;
+    r = &sim->nodes[rx->node];
+
+    if(!r->radio_on || r->tx_end > start) {
+      rx->ok = 0;
+    } else if(r->current == NULL) {
+      r->current = a;
+    } else {
+      /* collision, unless one of the two is much stronger */
+      c = r->current;
+      for(k = 0; c->rx[k].node != rx->node; k++);
+      if(rx->rssi >= c->rx[k].rssi + sim->capture) {
+        c->rx[k].ok = 0;
+        r->current = a;
+      } else if(c->rx[k].rssi >= rx->rssi + sim->capture) {
+        rx->ok = 0;
+      } else {
+        c->rx[k].ok = 0;
+        rx->ok = 0;
+      }
+      sim->collided++;
+    }
+    r->busy++;
+  }
+
+  for(p = &sim->on_air; *p != NULL && (*p)->end <= a->end; p = &(*p)->next);
+  a->next = *p;
+  *p = a;
+}
+/*---------------------------------------------------------------------------*/
+static void
+air_end(struct sim_air *a)
+{
+  struct sim_air_rx *rx;
+  struct sim_node *r;
+  int i;
+
+  for(i = 0; i < a->nrx; i++) {
+    rx = &a->rx[i];
+    r = &sim->nodes[rx->node];
+    if(r->current == a) {
+      r->current = NULL;
+    }
+    r->busy--;
+
+    if(!rx->ok || !r->radio_on) {
+      continue;
+    }
+    if(sim->loss && sim_random(&sim->rand) % 100 < sim->loss) {
+      sim->lost++;
+      continue;
+    }
+
+    sim->rx++;
+    node_load(rx->node);
+    sim_radio_input(a->frame, a->len, rx->rssi);
+    node_run();
+  }
+}
+/*---------------------------------------------------------------------------*/
+static double
+wall_time(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+/*---------------------------------------------------------------------------*/
+int
+select_set_callback(int fd, const struct select_callback *callback)
+{
+  /* nothing but virtual time in a simulation */
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char **argv)
+{
+  uint64_t end, t_node, t_air;
+  struct sim_air *a;
+  uint8_t *pristine;
+  int n = 10, range = 2, seed = 1, seconds = 60, opt, i;
+  double start;
+
+  sim = calloc(1, sizeof(struct sim));
+  sim->bitrate = 38400;
+  sim->capture = 6;
+
+  while((opt = getopt(argc, argv, "+n:T:r:b:l:c:S:")) != -1) {
+    switch(opt) {
+    case 'n':
+      n = atoi(optarg);
+      break;
+    case 'T':
+      seconds = atoi(optarg);
+      break;
+    case 'r':
+      range = atoi(optarg);
+      break;
+    case 'b':
+      sim->bitrate = atol(optarg);
+      break;
+    case 'l':
+      sim->loss = atoi(optarg);
+      break;
+    case 'c':
+      sim->capture = atoi(optarg);
+      break;
+    case 'S':
+      seed = atoi(optarg);
+      break;
+    default:
+      fprintf(stderr, "usage: %s [-n nodes] [-T seconds] [-r range] "
+              "[-b bit/s] [-l loss %%] [-c capture dB] [-S seed] "
+              "[-- app args]\n", argv[0]);
+      return 1;
+    }
+  }
+  if(n < 1 || n > 65534 || range < 1 || sim->bitrate <= 0) {
+    fprintf(stderr, "sim: bad arguments\n");
+    return 1;
+  }
+
+  /* the application sees its own arguments only */
+  argv[optind - 1] = argv[0];
+  contiki_argc = argc - optind + 1;
+  contiki_argv = argv + optind - 1;
+
+  sim->n = n;
+  sim->cur = -1;
+  sim->nodes = calloc(n, sizeof(struct sim_node));
+  sim->heap = malloc(n * sizeof(int));
+  pristine = malloc(IMAGE_SIZE);
+  if(sim->nodes == NULL || sim->heap == NULL || pristine == NULL) {
+    fprintf(stderr, "sim: out of memory\n");
+    return 1;
+  }
+  for(i = 0; i < n; i++) {
+    sim->nodes[i].image = malloc(IMAGE_SIZE);
+    if(sim->nodes[i].image == NULL) {
+      fprintf(stderr, "sim: out of memory at node %d\n", i);
+      return 1;
+    }
+    sim->nodes[i].wake = SIM_NEVER;
+    sim->nodes[i].rtimer = SIM_NEVER;
+    sim->nodes[i].pos = i;
+    sim->heap[i] = i;
+  }
+  topology_grid(range);
+
+  printf("sim: %d nodes of %lu bytes, %d s\n", n, (unsigned long)IMAGE_SIZE,
+         seconds);
+  start = wall_time();
+
+  /* the nodes take the seeds from seed to seed + n - 1 */
+  sim->rand = seed + n;
+
+  /* every node starts from the image as it is now */
+  memcpy(pristine, IMAGE_BASE, IMAGE_SIZE);
+  for(i = 0; i < n; i++) {
+    node_boot(i, pristine, seed);
+  }
+
+  end = (uint64_t)seconds * 1000000;
+  while(1) {
+    t_node = sim->nodes[sim->heap[0]].wake;
+    t_air = sim->on_air != NULL ? sim->on_air->end : SIM_NEVER;
+    if((t_node < t_air ? t_node : t_air) > end) {
+      break;
+    }
+
+    sim->events++;
+    if(t_air <= t_node) {
+      a = sim->on_air;
+      sim->on_air = a->next;
+      sim->now = t_air;
+      air_end(a);
+      free(a);
+    } else {
+      sim->now = t_node;
+      node_load(sim->heap[0]);
+      node_run();
+    }
+  }
+
+  printf("sim: %d s in %.2f s, %lu events, tx %lu rx %lu collided %lu "
+         "lost %lu\n", seconds, wall_time() - start, sim->events, sim->tx,
+         sim->rx, sim->collided, sim->lost);
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+void
+log_message(char *m1, char *m2)
+{
+  printf("%s%s\n", m1, m2);
+}
+/*---------------------------------------------------------------------------*/
+void
+uip_log(char *m)
+{
+  printf("%s\n", m);
+}
+/*---------------------------------------------------------------------------*/
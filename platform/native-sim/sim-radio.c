@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Radio driver of the simulated nodes: the frames go to the
+ *         medium of sim-main.c, that calls sim_radio_input() on the
+ *         receivers when their airtime is over.
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#include "contiki.h"
+#include "net/netstack.h"
+#include "net/packetbuf.h"
+#include "dev/radio.h"
+#include "sim.h"
+
+#include <string.h>
+
+#define MAX_FRAME 127
+
+static uint8_t tx_buf[MAX_FRAME];
+static uint8_t tx_len;
+/*---------------------------------------------------------------------------*/
+void
+sim_radio_input(const uint8_t *frame, uint8_t len, int8_t rssi)
+{
+  packetbuf_clear();
+  memcpy(packetbuf_dataptr(), frame, len);
+  packetbuf_set_datalen(len);
+  packetbuf_set_attr(PACKETBUF_ATTR_RSSI, rssi);
+  NETSTACK_RDC.input();
+}
+/*---------------------------------------------------------------------------*/
+static int
+init(void)
+{
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+prepare(const void *payload, unsigned short payload_len)
+{
+  if(payload_len > MAX_FRAME) {
+    return 1;
+  }
+  memcpy(tx_buf, payload, payload_len);
+  tx_len = payload_len;
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static int
+transmit(unsigned short transmit_len)
+{
+  if(transmit_len != tx_len) {
+    return RADIO_TX_ERR;
+  }
+  sim_air_start(tx_buf, tx_len);
+  return RADIO_TX_OK;
+}
+/*---------------------------------------------------------------------------*/
+static int
+send_packet(const void *payload, unsigned short payload_len)
+{
+  if(prepare(payload, payload_len)) {
+    return RADIO_TX_ERR;
+  }
+  return transmit(payload_len);
+}
+/*---------------------------------------------------------------------------*/
+static int
+read_packet(void *buf, unsigned short buf_len)
+{
+  /* frames are pushed by sim_radio_input() */
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static int
+channel_clear(void)
+{
+  return sim_node()->busy == 0;
+}
+/*---------------------------------------------------------------------------*/
+static int
+receiving_packet(void)
+{
+  return sim_node()->radio_on && sim_node()->busy != 0;
+}
+/*---------------------------------------------------------------------------*/
+static int
+pending_packet(void)
+{
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static int
+on(void)
+{
+  sim_node()->radio_on = 1;
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+off(void)
+{
+  sim_node()->radio_on = 0;
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+const struct radio_driver sim_radio_driver = {
+  init,
+  prepare,
+  transmit,
+  send_packet,
+  read_packet,
+  channel_clear,
+  receiving_packet,
+  pending_packet,
+  on,
+  off,
+};
+/*---------------------------------------------------------------------------*/
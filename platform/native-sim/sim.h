@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Many native nodes in one process, on virtual time.
+ *
+ *         Every node owns a copy of the .data and .bss of the program
+ *         (__data_start to _end): process list, etimers, packetbuf,
+ *         rimeaddr_node_addr... sim-main.c copies the image of a node in
+ *         place before running it, so Contiki and the application run
+ *         unchanged. The simulator itself keeps its state on the heap,
+ *         behind the sim pointer, that is the same in every image.
+ *
+ *         Time jumps from an event to the next one: the earliest etimer or
+ *         rtimer of a node or the end of a frame on air. The run only depends on
+ *         the arguments and on the seed, so it is reproducible. Every node
+ *         draws random numbers from its own state, in its image, and the
+ *         medium from another one.
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#ifndef SIM_H_
+#define SIM_H_
+
+#include <stdint.h>
+
+#define SIM_NEVER UINT64_MAX
+
+struct sim_air;
+
+struct sim_node {
+  uint8_t *image;
+  uint64_t wake;           /* next etimer or rtimer, us, SIM_NEVER if none */
+  uint64_t rtimer;         /* next rtimer */
+  int pos;                 /* in the wake up heap */
+
+  /* radio: neighbors in range and what is on air around the node */
+  int *nbrs;
+  int8_t *nbr_rssi;
+  int nnbrs;
+  int busy;
+  struct sim_air *current;
+  uint64_t tx_end;
+  uint8_t radio_on;
+};
+
+struct sim {
+  uint64_t now;            /* virtual time, us */
+  int cur;                 /* the node whose image is in place */
+  int n;
+  struct sim_node *nodes;
+  int *heap;
+  struct sim_air *on_air;  /* sorted by end */
+
+  long bitrate;
+  int loss;                /* % */
+  uint32_t rand;           /* random state of the medium, see sim_random() */
+  int capture;             /* dB */
+
+  unsigned long events, tx, rx, collided, lost;
+};
+
+extern struct sim *sim;
+
+#define sim_node() (&sim->nodes[sim->cur])
+
+/* Called by the radio driver of the running node */
+void sim_air_start(const uint8_t *frame, uint8_t len);
+
+/* Hand a frame to the running node, see sim-radio.c */
+void sim_radio_input(const uint8_t *frame, uint8_t len, int8_t rssi);
+
+/* Next random number of the sequence in *s, see random.c */
+uint16_t sim_random(uint32_t *s);
+
+#endif /* SIM_H_ */
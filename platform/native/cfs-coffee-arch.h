@@ -42,11 +42,13 @@
 
 #include "contiki-conf.h"
 #include "dev/xmem.h"
+#include "dev/xmem-arch.h"
 
 #define COFFEE_SECTOR_SIZE		65536UL
 #define COFFEE_PAGE_SIZE		256UL
 #define COFFEE_START			0
-#define COFFEE_SIZE			((1024UL * 1024UL) - COFFEE_START)
+/* the whole mapped file, see dev/xmem-arch.h */
+#define COFFEE_SIZE			(XMEM_SIZE - COFFEE_START)
 #define COFFEE_NAME_LENGTH		16
 #define COFFEE_DYN_SIZE			16384
 #define COFFEE_MAX_OPEN_FILES		6
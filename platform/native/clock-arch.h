@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Native time base: CLOCK_MONOTONIC, in microseconds from the
+ *         start of the node.
+ *
+ *         The time can run faster than the real one: CLOCK_CONF_SCALE, or
+ *         $CONTIKI_TIME_SCALE, is how many seconds of node time go by in a
+ *         real second. The clock, the rtimers and the sleep of the main
+ *         loop all follow it.
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#ifndef __CLOCK_ARCH_H__
+#define __CLOCK_ARCH_H__
+
+#include "contiki-conf.h"
+
+#ifdef CLOCK_CONF_SCALE
+#define CLOCK_SCALE CLOCK_CONF_SCALE
+#else
+#define CLOCK_SCALE 1
+#endif
+
+/* Node time in microseconds */
+uint64_t clock_arch_us(void);
+
+/* Node seconds in a real second */
+unsigned clock_arch_scale(void);
+
+#endif /* __CLOCK_ARCH_H__ */
@@ -32,39 +32,66 @@
 
 /**
  * \file
- *         Clock implementation for Unix.
+ *         Clock implementation for Unix, on CLOCK_MONOTONIC: see clock-arch.h
  * \author
  *         Adam Dunkels <adam@sics.se>
  */
 
 #include "sys/clock.h"
+#include "clock-arch.h"
+
+#include <stdlib.h>
 #include <time.h>
-#include <sys/time.h>
 
+static struct timespec start;
+static unsigned scale;
+/*---------------------------------------------------------------------------*/
+unsigned
+clock_arch_scale(void)
+{
+  const char *env;
+
+  if(scale == 0) {
+    env = getenv("CONTIKI_TIME_SCALE");
+    scale = env != NULL && atoi(env) > 0 ? atoi(env) : CLOCK_SCALE;
+  }
+  return scale;
+}
+/*---------------------------------------------------------------------------*/
+uint64_t
+clock_arch_us(void)
+{
+  struct timespec ts;
+  uint64_t us;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  if(start.tv_sec == 0 && start.tv_nsec == 0) {
+    start = ts;
+  }
+
+  us = (uint64_t)(ts.tv_sec - start.tv_sec) * 1000000 +
+    (ts.tv_nsec - start.tv_nsec) / 1000;
+  return us * clock_arch_scale();
+}
 /*---------------------------------------------------------------------------*/
 clock_time_t
 clock_time(void)
 {
-  struct timeval tv;
-   
-  gettimeofday(&tv, NULL);
- 
-  return tv.tv_sec * 1000 + tv.tv_usec / 1000;
+  return clock_arch_us() / (1000000 / CLOCK_SECOND);
 }
 /*---------------------------------------------------------------------------*/
 unsigned long
 clock_seconds(void)
 {
-  struct timeval tv;
-   
-  gettimeofday(&tv, NULL);
- 
-  return tv.tv_sec;
+  return clock_arch_us() / 1000000;
 }
 /*---------------------------------------------------------------------------*/
+/* Busy wait for d microseconds of node time */
 void
 clock_delay(unsigned int d)
 {
-  /* Does not do anything. */
+  uint64_t end = clock_arch_us() + d;
+
+  while(clock_arch_us() < end);
 }
 /*---------------------------------------------------------------------------*/
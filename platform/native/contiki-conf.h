@@ -88,10 +88,6 @@ typedef unsigned short uip_stats_t;
 #define NETSTACK_CONF_RDC     nullrdc_driver
 #endif /* NETSTACK_CONF_RDC */
 
-#ifndef NETSTACK_CONF_RADIO
-#define NETSTACK_CONF_RADIO   nullradio_driver
-#endif /* NETSTACK_CONF_RADIO */
-
 #ifndef NETSTACK_CONF_FRAMER
 #define NETSTACK_CONF_FRAMER  framer_802154
 #endif /* NETSTACK_CONF_FRAMER */
@@ -165,6 +161,11 @@ typedef unsigned short uip_stats_t;
 
 #endif /* UIP_CONF_IPV6 */
 
+/* The nodes share the radio medium of tools/medium, see dev/vradio.h */
+#ifndef NETSTACK_CONF_RADIO
+#define NETSTACK_CONF_RADIO   vradio_driver
+#endif /* NETSTACK_CONF_RADIO */
+
 typedef unsigned long clock_time_t;
 
 #define CLOCK_CONF_SECOND 1000
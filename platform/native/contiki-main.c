@@ -31,16 +31,23 @@
  *
  */
 
+#include <errno.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 #include <sys/select.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#define SELECT_EPOLL 1
+#endif
 
 #ifdef __CYGWIN__
 #include "net/wpcap-drv.h"
 #endif /* __CYGWIN__ */
 
 #include "contiki.h"
+#include "clock-arch.h"
 #include "net/netstack.h"
 
 #include "dev/serial-line.h"
@@ -57,20 +64,105 @@
 
 #include "net/rime.h"
 
+/* The callbacks take fd_sets: FD_SETSIZE is the real limit */
 #ifdef SELECT_CONF_MAX
 #define SELECT_MAX SELECT_CONF_MAX
 #else
-#define SELECT_MAX 8
+#define SELECT_MAX FD_SETSIZE
 #endif
 
 static const struct select_callback *select_callback[SELECT_MAX];
 static int select_max = 0;
 
+#if SELECT_EPOLL
+#define EPOLL_EVENTS_MAX 32
+/* epoll does not take regular files: they are always ready, as in select() */
+#define SELECT_ALWAYS    0x80000000
+
+static int epoll_fd = -1;
+static uint32_t select_events[SELECT_MAX];
+static int select_always;
+#endif
+
 SENSORS(&pir_sensor, &vib_sensor, &button_sensor);
 
 static uint8_t serial_id[] = {0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08};
 static uint16_t node_id = 0x0102;
 /*---------------------------------------------------------------------------*/
+#if SELECT_EPOLL
+/*
+ * Ask the callback of fd which events it waits for and tell epoll, only
+ * when they change. The main loop asks every callback before each wait, as
+ * select() would: a process may want to write to an fd whose handle_fd()
+ * did not run.
+ */
+static void
+select_update(int fd)
+{
+  struct epoll_event ev;
+  fd_set fdr, fdw;
+  uint32_t events = 0;
+
+  if(select_callback[fd] != NULL) {
+    FD_ZERO(&fdr);
+    FD_ZERO(&fdw);
+    if(select_callback[fd]->set_fd(&fdr, &fdw)) {
+      events = (FD_ISSET(fd, &fdr) ? EPOLLIN : 0) |
+        (FD_ISSET(fd, &fdw) ? EPOLLOUT : 0);
+    }
+  }
+  if(events == (select_events[fd] & ~SELECT_ALWAYS)) {
+    return;
+  }
+
+  memset(&ev, 0, sizeof(ev));
+  ev.events = events;
+  ev.data.fd = fd;
+  if(select_events[fd] & SELECT_ALWAYS) {
+    if(events == 0) {
+      select_always--;
+    } else {
+      events |= SELECT_ALWAYS;
+    }
+  } else if(select_events[fd] == 0) {
+    if(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+      if(errno != EPERM) {
+        perror("epoll_ctl");
+        return;
+      }
+      events |= SELECT_ALWAYS;
+      select_always++;
+    }
+  } else if(events == 0) {
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, &ev);
+  } else {
+    epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &ev);
+  }
+  select_events[fd] = events;
+}
+/*---------------------------------------------------------------------------*/
+static void
+select_dispatch(int fd, uint32_t events)
+{
+  fd_set fdr, fdw;
+
+  if(select_callback[fd] == NULL) {
+    return;
+  }
+
+  FD_ZERO(&fdr);
+  FD_ZERO(&fdw);
+  if((select_events[fd] & EPOLLIN) &&
+     (events & (EPOLLIN | EPOLLHUP | EPOLLERR))) {
+    FD_SET(fd, &fdr);
+  }
+  if((select_events[fd] & EPOLLOUT) && (events & (EPOLLOUT | EPOLLERR))) {
+    FD_SET(fd, &fdw);
+  }
+  select_callback[fd]->handle_fd(&fdr, &fdw);
+}
+#endif /* SELECT_EPOLL */
+/*---------------------------------------------------------------------------*/
 int
 select_set_callback(int fd, const struct select_callback *callback)
 {
@@ -82,7 +174,17 @@ select_set_callback(int fd, const struct select_callback *callback)
       callback = NULL;
     }
 
+#if SELECT_EPOLL
+    if(callback != NULL && select_events[fd] != 0) {
+      /* maybe a new fd with the same number: start from scratch */
+      select_callback[fd] = NULL;
+      select_update(fd);
+    }
+    select_callback[fd] = callback;
+    select_update(fd);
+#else
     select_callback[fd] = callback;
+#endif
 
     /* Update fd max */
     if(callback != NULL) {
@@ -112,10 +214,15 @@ stdin_set_fd(fd_set *rset, fd_set *wset)
 static void
 stdin_handle_fd(fd_set *rset, fd_set *wset)
 {
+  ssize_t n;
   char c;
   if(FD_ISSET(STDIN_FILENO, rset)) {
-    if(read(STDIN_FILENO, &c, 1) > 0) {
+    n = read(STDIN_FILENO, &c, 1);
+    if(n > 0) {
       serial_line_input_byte(c);
+    } else if(n == 0) {
+      /* end of input, do not spin on it */
+      select_set_callback(STDIN_FILENO, NULL);
     }
   }
 }
@@ -151,6 +258,26 @@ set_rime_addr(void)
 }
 
 
+/*---------------------------------------------------------------------------*/
+/* Real milliseconds to the next etimer, -1 if there is none */
+static int
+next_timeout(void)
+{
+  clock_time_t now, next;
+
+  if(!etimer_pending()) {
+    return -1;
+  }
+
+  now = clock_time();
+  next = etimer_next_expiration_time();
+  if(!CLOCK_LT(now, next)) {
+    return 0;
+  }
+  /* round up: waking up early only means another pass */
+  return ((next - now) * 1000 / CLOCK_SECOND + clock_arch_scale() - 1) /
+    clock_arch_scale();
+}
 /*---------------------------------------------------------------------------*/
 int contiki_argc = 0;
 char **contiki_argv;
@@ -168,6 +295,19 @@ main(int argc, char **argv)
   printf(CONTIKI_VERSION_STRING " started\n");
 #endif
 
+  /* the nodes on the same virtual radio medium need their own address */
+  if(getenv("NODE_ID") != NULL) {
+    node_id = strtol(getenv("NODE_ID"), NULL, 0);
+  }
+
+#if SELECT_EPOLL
+  epoll_fd = epoll_create1(0);
+  if(epoll_fd < 0) {
+    perror("epoll_create1");
+    return 1;
+  }
+#endif
+
   /* crappy way of remembering and accessing argc/v */
   contiki_argc = argc;
   contiki_argv = argv;
@@ -187,6 +327,7 @@ main(int argc, char **argv)
   process_init();
   process_start(&etimer_process, NULL);
   ctimer_init();
+  rtimer_init();
 
   set_rime_addr();
 
@@ -216,7 +357,7 @@ main(int argc, char **argv)
 
     printf("%02x%02x\n", lladdr->ipaddr.u8[14], lladdr->ipaddr.u8[15]);
   }
-#else
+#elif !CONTIKI_NO_NET
   process_start(&tcpip_process, NULL);
 #endif
 
@@ -229,17 +370,47 @@ main(int argc, char **argv)
 
   select_set_callback(STDIN_FILENO, &stdin_fd);
   while(1) {
+#if SELECT_EPOLL
+    struct epoll_event events[EPOLL_EVENTS_MAX];
+    int timeout;
+    int i;
+    int n;
+
+    n = process_run();
+    for(i = 0; i <= select_max; i++) {
+      select_update(i);
+    }
+
+    /* sleep until an fd or the next etimer needs us */
+    timeout = n || select_always ? 0 : next_timeout();
+
+    n = epoll_wait(epoll_fd, events, EPOLL_EVENTS_MAX, timeout);
+    if(n < 0 && errno != EINTR) {
+      perror("epoll_wait");
+    }
+    for(i = 0; i < n; i++) {
+      select_dispatch(events[i].data.fd, events[i].events);
+    }
+    if(select_always) {
+      for(i = 0; i <= select_max; i++) {
+        if(select_events[i] & SELECT_ALWAYS) {
+          select_dispatch(i, EPOLLIN | EPOLLOUT);
+        }
+      }
+    }
+#else
     fd_set fdr;
     fd_set fdw;
     int maxfd;
     int i;
     int retval;
     struct timeval tv;
+    int timeout;
 
-    retval = process_run();
+    timeout = process_run() ? 0 : next_timeout();
 
-    tv.tv_sec = 0;
-    tv.tv_usec = retval ? 1 : 1000;
+    tv.tv_sec = timeout / 1000;
+    tv.tv_usec = (timeout % 1000) * 1000;
 
     FD_ZERO(&fdr);
     FD_ZERO(&fdw);
@@ -250,7 +421,7 @@ main(int argc, char **argv)
       }
     }
 
-    retval = select(maxfd + 1, &fdr, &fdw, NULL, &tv);
+    retval = select(maxfd + 1, &fdr, &fdw, NULL, timeout < 0 ? NULL : &tv);
     if(retval < 0) {
       perror("select");
     } else if(retval > 0) {
@@ -261,8 +432,12 @@ main(int argc, char **argv)
         }
       }
     }
+#endif /* SELECT_EPOLL */
 
-    etimer_request_poll();
+    if(etimer_pending() &&
+       !CLOCK_LT(clock_time(), etimer_next_expiration_time())) {
+      etimer_request_poll();
+    }
   }
 
   return 0;
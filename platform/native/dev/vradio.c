@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Virtual radio driver of the native platform, see vradio.h
+ *
+ *         Without a medium broker to connect to the driver behaves like
+ *         nullradio: the node runs, nothing goes on air.
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#include "contiki.h"
+#include "net/netstack.h"
+#include "net/packetbuf.h"
+#include "net/rime/rimeaddr.h"
+#include "dev/vradio.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/* Frames received and not yet read by the RDC */
+#ifdef VRADIO_CONF_RX_QUEUE
+#define RX_QUEUE VRADIO_CONF_RX_QUEUE
+#else
+#define RX_QUEUE 8
+#endif
+
+struct rx_frame {
+  uint8_t len;
+  int8_t rssi;
+  uint8_t lqi;
+  uint8_t data[VRADIO_MAX_FRAME];
+};
+
+static int fd = -1;
+static uint8_t is_on;
+static uint8_t busy;
+
+static struct rx_frame rx_queue[RX_QUEUE];
+static uint8_t rx_head, rx_count;
+
+static uint8_t tx_buf[1 + VRADIO_MAX_FRAME];
+static uint8_t tx_len;
+
+PROCESS(vradio_process, "Virtual radio");
+/*---------------------------------------------------------------------------*/
+static int
+set_fd(fd_set *rset, fd_set *wset)
+{
+  FD_SET(fd, rset);
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+handle_fd(fd_set *rset, fd_set *wset)
+{
+  uint8_t msg[VRADIO_RX_HDR + VRADIO_MAX_FRAME];
+  struct rx_frame *f;
+  ssize_t n;
+
+  if(!FD_ISSET(fd, rset)) {
+    return;
+  }
+
+  while((n = recv(fd, msg, sizeof(msg), MSG_DONTWAIT)) > 0) {
+    switch(msg[0]) {
+    case VRADIO_BUSY:
+      busy = 1;
+      break;
+    case VRADIO_IDLE:
+      busy = 0;
+      break;
+    case VRADIO_RX:
+      /* a sleeping radio hears nothing */
+      if(!is_on || n <= VRADIO_RX_HDR || rx_count == RX_QUEUE) {
+        break;
+      }
+      f = &rx_queue[(rx_head + rx_count) % RX_QUEUE];
+      f->rssi = (int8_t)msg[1];
+      f->lqi = msg[2];
+      f->len = n - VRADIO_RX_HDR;
+      memcpy(f->data, msg + VRADIO_RX_HDR, f->len);
+      rx_count++;
+      process_poll(&vradio_process);
+      break;
+    }
+  }
+
+  if(n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+    printf("vradio: medium gone\n");
+    select_set_callback(fd, NULL);
+    close(fd);
+    fd = -1;
+    busy = 0;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static const struct select_callback vradio_callback = {
+  set_fd, handle_fd
+};
+/*---------------------------------------------------------------------------*/
+static int
+init(void)
+{
+  struct sockaddr_un addr;
+  const char *path;
+  uint8_t hello[1 + 2];
+
+  path = getenv("VRADIO_SOCKET");
+  if(path == NULL) {
+    path = VRADIO_SOCKET;
+  }
+
+  fd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+  if(fd < 0) {
+    return 0;
+  }
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+  if(connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+    printf("vradio: no medium on %s, radio disabled\n", path);
+    close(fd);
+    fd = -1;
+    return 0;
+  }
+
+  hello[0] = VRADIO_HELLO;
+  hello[1] = rimeaddr_node_addr.u8[0];
+  hello[2] = rimeaddr_node_addr.u8[1];
+  send(fd, hello, sizeof(hello), 0);
+
+  if(!select_set_callback(fd, &vradio_callback)) {
+    printf("vradio: fd %d beyond SELECT_CONF_MAX\n", fd);
+    close(fd);
+    fd = -1;
+    return 0;
+  }
+
+  process_start(&vradio_process, NULL);
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+prepare(const void *payload, unsigned short payload_len)
+{
+  if(payload_len > VRADIO_MAX_FRAME) {
+    return 1;
+  }
+  tx_buf[0] = VRADIO_TX;
+  memcpy(tx_buf + 1, payload, payload_len);
+  tx_len = payload_len;
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static int
+transmit(unsigned short transmit_len)
+{
+  if(fd < 0 || transmit_len != tx_len) {
+    return RADIO_TX_ERR;
+  }
+  if(send(fd, tx_buf, 1 + tx_len, 0) < 0) {
+    return RADIO_TX_ERR;
+  }
+  return RADIO_TX_OK;
+}
+/*---------------------------------------------------------------------------*/
+static int
+send_packet(const void *payload, unsigned short payload_len)
+{
+  if(prepare(payload, payload_len)) {
+    return RADIO_TX_ERR;
+  }
+  return transmit(payload_len);
+}
+/*---------------------------------------------------------------------------*/
+static int
+read_packet(void *buf, unsigned short buf_len)
+{
+  struct rx_frame *f;
+  int len;
+
+  if(rx_count == 0) {
+    return 0;
+  }
+
+  f = &rx_queue[rx_head];
+  len = f->len < buf_len ? f->len : buf_len;
+  memcpy(buf, f->data, len);
+  packetbuf_set_attr(PACKETBUF_ATTR_RSSI, f->rssi);
+  packetbuf_set_attr(PACKETBUF_ATTR_LINK_QUALITY, f->lqi);
+
+  rx_head = (rx_head + 1) % RX_QUEUE;
+  rx_count--;
+  return len;
+}
+/*---------------------------------------------------------------------------*/
+static int
+channel_clear(void)
+{
+  return !busy;
+}
+/*---------------------------------------------------------------------------*/
+static int
+receiving_packet(void)
+{
+  return is_on && busy;
+}
+/*---------------------------------------------------------------------------*/
+static int
+pending_packet(void)
+{
+  return rx_count != 0;
+}
+/*---------------------------------------------------------------------------*/
+static int
+on(void)
+{
+  is_on = 1;
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+off(void)
+{
+  is_on = 0;
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(vradio_process, ev, data)
+{
+  int len;
+
+  PROCESS_BEGIN();
+
+  while(1) {
+    PROCESS_YIELD_UNTIL(ev == PROCESS_EVENT_POLL);
+
+    while(rx_count != 0) {
+      packetbuf_clear();
+      len = read_packet(packetbuf_dataptr(), PACKETBUF_SIZE);
+      if(len > 0) {
+        packetbuf_set_datalen(len);
+        NETSTACK_RDC.input();
+      }
+    }
+  }
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+const struct radio_driver vradio_driver = {
+  init,
+  prepare,
+  transmit,
+  send_packet,
+  read_packet,
+  channel_clear,
+  receiving_packet,
+  pending_packet,
+  on,
+  off,
+};
+/*---------------------------------------------------------------------------*/
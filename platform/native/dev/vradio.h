@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Virtual radio of the native platform.
+ *
+ *         Every native node connects to a medium broker (tools/medium) on
+ *         a UNIX SOCK_SEQPACKET socket, one message per packet, first byte
+ *         the message type:
+ *
+ *           node -> medium   VRADIO_HELLO  addr[2]      (once, at init)
+ *                            VRADIO_TX     frame
+ *           medium -> node   VRADIO_RX     rssi lqi frame
+ *                            VRADIO_BUSY                (carrier on)
+ *                            VRADIO_IDLE                (carrier off)
+ *
+ *         The medium delays the frames by their airtime and applies the
+ *         loss, RSSI and collision models, the node only queues what it
+ *         receives while its radio is on.
+ *
+ *         The broker socket is VRADIO_CONF_SOCKET, or $VRADIO_SOCKET.
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#ifndef VRADIO_H_
+#define VRADIO_H_
+
+#define VRADIO_HELLO     'H'
+#define VRADIO_TX        'T'
+#define VRADIO_RX        'R'
+#define VRADIO_BUSY      'B'
+#define VRADIO_IDLE      'I'
+
+#define VRADIO_MAX_FRAME 127
+
+/* VRADIO_RX header: type, rssi, lqi */
+#define VRADIO_RX_HDR    3
+
+#ifdef VRADIO_CONF_SOCKET
+#define VRADIO_SOCKET VRADIO_CONF_SOCKET
+#else
+#define VRADIO_SOCKET "/tmp/zakke-medium"
+#endif
+
+#ifdef CONTIKI
+#include "dev/radio.h"
+
+extern const struct radio_driver vradio_driver;
+#endif
+
+#endif /* VRADIO_H_ */
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Native xmem on a memory mapped file, that outlives the node.
+ *
+ *         Every node maps its own file, XMEM_CONF_FILE or $XMEM_FILE
+ *         followed by a dot and the node id, the Rime address as a little
+ *         endian number (xmem.1 for the node 1.0). A shorter file is
+ *         extended to XMEM_SIZE with zero bytes (the erased state of the
+ *         native xmem), a size that is a multiple of the Coffee sector.
+ *         Only the pages in use take memory.
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#ifndef XMEM_ARCH_H_
+#define XMEM_ARCH_H_
+
+#include "contiki-conf.h"
+
+#ifdef XMEM_CONF_SIZE
+#define XMEM_SIZE XMEM_CONF_SIZE
+#else
+#define XMEM_SIZE (1024UL * 1024UL)
+#endif
+
+#ifdef XMEM_CONF_FILE
+#define XMEM_FILE XMEM_CONF_FILE
+#else
+#define XMEM_FILE "xmem"
+#endif
+
+/* Write the changes to the file now, not when the kernel likes to */
+int xmem_arch_sync(void);
+
+#endif /* XMEM_ARCH_H_ */
@@ -32,33 +32,81 @@
  *
  */
 
+/*
+ * Memory mapped xmem, see xmem-arch.h
+ */
+
 #include "contiki-conf.h"
 #include "dev/xmem.h"
+#include "dev/xmem-arch.h"
+#include "net/rime/rimeaddr.h"
 
-#include <stdio.h>
 #include <fcntl.h>
-#include <unistd.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static unsigned char *xmem;
+/*---------------------------------------------------------------------------*/
+/* Map the file of this node on first use: its name needs the address */
+static int
+xmem_map(void)
+{
+  const char *base;
+  char name[256];
+  struct stat st;
+  void *p;
+  int f;
+
+  if(xmem != NULL) {
+    return 1;
+  }
+
+  base = getenv("XMEM_FILE");
+  if(base == NULL) {
+    base = XMEM_FILE;
+  }
+  snprintf(name, sizeof(name), "%s.%u", base,
+           rimeaddr_node_addr.u8[0] | (rimeaddr_node_addr.u8[1] << 8));
 
-#define XMEM_SIZE 1024 * 1024
+  /* a new file grows to XMEM_SIZE, a larger one keeps what is past it */
+  f = open(name, O_RDWR | O_CREAT, 0644);
+  if(f < 0 || fstat(f, &st) < 0 ||
+     (st.st_size < XMEM_SIZE && ftruncate(f, XMEM_SIZE) < 0)) {
+    perror(name);
+    if(f >= 0) {
+      close(f);
+    }
+    return 0;
+  }
 
-static unsigned char xmem[XMEM_SIZE];
+  p = mmap(NULL, XMEM_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, f, 0);
+  close(f);
+  if(p == MAP_FAILED) {
+    perror(name);
+    return 0;
+  }
+
+  xmem = p;
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+xmem_range(long size, unsigned long offset)
+{
+  return size >= 0 && offset <= XMEM_SIZE && size <= XMEM_SIZE - offset &&
+    xmem_map();
+}
 /*---------------------------------------------------------------------------*/
 int
 xmem_pwrite(const void *buf, int size, unsigned long offset)
 {
-  /*  int f;
-  char name[400];
-
-  snprintf(name, sizeof(name), "xmem.%d.%d", node_x(), node_y());
-  f = open(name, O_WRONLY | O_APPEND | O_CREAT, 0644);
-  lseek(f, addr, SEEK_SET);
-  write(f, buf, size);
-  close(f);*/
-  
-  /*  printf("xmem_write(offset 0x%02x, buf %p, size %l);\n", offset, buf, size);*/
-  
+  if(!xmem_range(size, offset)) {
+    return -1;
+  }
   memcpy(&xmem[offset], buf, size);
   return size;
 }
@@ -66,7 +114,9 @@ xmem_pwrite(const void *buf, int size, unsigned long offset)
 int
 xmem_pread(void *buf, int size, unsigned long offset)
 {
-  /*  printf("xmem_read(addr 0x%02x, buf %p, size %d);\n", addr, buf, size);*/
+  if(!xmem_range(size, offset)) {
+    return -1;
+  }
   memcpy(buf, &xmem[offset], size);
   return size;
 }
@@ -74,14 +124,25 @@ xmem_pread(void *buf, int size, unsigned long offset)
 int
 xmem_erase(long nbytes, unsigned long offset)
 {
-  /*  printf("xmem_read(addr 0x%02x, buf %p, size %d);\n", addr, buf, size);*/
+  if(!xmem_range(nbytes, offset)) {
+    return -1;
+  }
   memset(&xmem[offset], 0, nbytes);
   return nbytes;
 }
 /*---------------------------------------------------------------------------*/
+int
+xmem_arch_sync(void)
+{
+  if(xmem == NULL) {
+    return 0;
+  }
+  return msync(xmem, XMEM_SIZE, MS_SYNC);
+}
+/*---------------------------------------------------------------------------*/
 void
 xmem_init(void)
 {
-
+  xmem_map();
 }
 /*---------------------------------------------------------------------------*/
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Native rtimers, see rtimer-arch.h
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#include "contiki.h"
+#include "sys/rtimer.h"
+#include "clock-arch.h"
+
+#include <stdio.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/timerfd.h>
+#endif
+
+#ifdef __linux__
+static int timer_fd = -1;
+/*---------------------------------------------------------------------------*/
+static int
+set_fd(fd_set *rset, fd_set *wset)
+{
+  FD_SET(timer_fd, rset);
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+handle_fd(fd_set *rset, fd_set *wset)
+{
+  uint64_t expirations;
+
+  if(FD_ISSET(timer_fd, rset) &&
+     read(timer_fd, &expirations, sizeof(expirations)) > 0) {
+    rtimer_run_next();
+  }
+}
+/*---------------------------------------------------------------------------*/
+static const struct select_callback rtimer_callback = {
+  set_fd, handle_fd
+};
+#endif /* __linux__ */
+/*---------------------------------------------------------------------------*/
+void
+rtimer_arch_init(void)
+{
+#ifdef __linux__
+  timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if(timer_fd < 0 || !select_set_callback(timer_fd, &rtimer_callback)) {
+    perror("rtimer: timerfd");
+  }
+#endif
+}
+/*---------------------------------------------------------------------------*/
+rtimer_clock_t
+rtimer_arch_now(void)
+{
+  return clock_arch_us() * RTIMER_ARCH_SECOND / 1000000;
+}
+/*---------------------------------------------------------------------------*/
+void
+rtimer_arch_schedule(rtimer_clock_t t)
+{
+#ifdef __linux__
+  struct itimerspec its;
+  int64_t ns;
+  short ticks;
+
+  ticks = (short)(t - rtimer_arch_now());
+  ns = ticks > 0 ? (int64_t)ticks * 1000000000 / RTIMER_ARCH_SECOND : 0;
+  ns /= clock_arch_scale();
+
+  its.it_interval.tv_sec = 0;
+  its.it_interval.tv_nsec = 0;
+  /* 0 would disarm the timer, a due one fires right away */
+  its.it_value.tv_sec = ns / 1000000000;
+  its.it_value.tv_nsec = ns > 0 ? ns % 1000000000 : 1;
+  timerfd_settime(timer_fd, 0, &its, NULL);
+#endif
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Native rtimers, on a timerfd and the node time of clock-arch.h
+ *
+ *         rtimer_clock_t has 16 bits: at 16 us a tick it wraps in about a
+ *         second, the CC1101 MAC windows are much shorter than that.
+ *
+ *         The callback runs from the main loop as soon as the timerfd
+ *         fires, not in the middle of a process: it is late by the time
+ *         the running process takes to return.
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#ifndef __RTIMER_ARCH_H__
+#define __RTIMER_ARCH_H__
+
+#include "contiki-conf.h"
+
+#ifdef RTIMER_ARCH_CONF_SECOND
+#define RTIMER_ARCH_SECOND RTIMER_ARCH_CONF_SECOND
+#else
+#define RTIMER_ARCH_SECOND 62500
+#endif
+
+rtimer_clock_t rtimer_arch_now(void);
+
+#endif /* __RTIMER_ARCH_H__ */
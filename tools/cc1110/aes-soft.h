@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Software AES-128 behind the dev/aes.h calls, for the host checks
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#ifndef AES_SOFT_H_
+#define AES_SOFT_H_
+
+#include "dev/aes.h"
+
+/* Encrypt one block in place with the key of the last aes_set_key() */
+void aes_soft_block(uint8_t *block);
+
+#endif /* AES_SOFT_H_ */
@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Host check of the link layer CCM (cpu/cc1110/net/ccm.c) on top of
+ *         a software AES. No published vector has M = 4, L = 2 and no
+ *         additional data, so the checks go in steps:
+ *
+ *         - the software AES against FIPS-197 appendix C.1;
+ *         - a plain CCM written from RFC 3610, with any M, L and
+ *           additional data, against RFC 3610 packet vector #1 (M = 8,
+ *           L = 2) and NIST SP 800-38C example 1 (M = 4, L = 8);
+ *         - ccm.c against that CCM with M = 4, L = 2 for every length up
+ *           to 255 bytes, then a flipped bit in the text or in the MIC
+ *           must make ccm_open() fail.
+ *
+ *         usage: ccm-test (exit status 0 if every check passes)
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#include "aes-soft.h"
+#include "net/ccm.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int failed;
+/*---------------------------------------------------------------------------*/
+static void
+check(const char *what, const uint8_t *got, const uint8_t *want, int len)
+{
+  int i;
+
+  if(memcmp(got, want, len) == 0) {
+    printf("ok   %s\n", what);
+    return;
+  }
+
+  failed++;
+  printf("FAIL %s\n     got  ", what);
+  for(i = 0; i < len; i++) {
+    printf("%02x", got[i]);
+  }
+  printf("\n     want ");
+  for(i = 0; i < len; i++) {
+    printf("%02x", want[i]);
+  }
+  printf("\n");
+}
+/*---------------------------------------------------------------------------*/
+/*
+ * CCM as in RFC 3610 section 2, straight from the text: encrypt 'p' into
+ * 'c' and append the M bytes MIC. The key is the last aes_set_key().
+ */
+static void
+ref_ccm(int m, int l, const uint8_t *nonce, const uint8_t *a, int alen,
+        const uint8_t *p, int plen, uint8_t *c)
+{
+  uint8_t x[AES_BLOCK_LEN];
+  uint8_t s[AES_BLOCK_LEN];
+  uint8_t blk[AES_BLOCK_LEN];
+  uint8_t *aad;
+  int aadlen;
+  int i, j, n;
+
+  /* B_0: flags, nonce, l(m) */
+  memset(x, 0, AES_BLOCK_LEN);
+  x[0] = (alen ? 0x40 : 0) | (((m - 2) / 2) << 3) | (l - 1);
+  memcpy(&x[1], nonce, 15 - l);
+  for(i = 0, n = plen; i < l; i++, n >>= 8) {
+    x[15 - i] = n;
+  }
+  aes_soft_block(x);
+
+  /* l(a) on two bytes, a, zero padded, then the message, zero padded */
+  aadlen = alen ? 2 + alen : 0;
+  aad = malloc(aadlen + 1);
+  if(alen) {
+    aad[0] = alen >> 8;
+    aad[1] = alen;
+    memcpy(&aad[2], a, alen);
+  }
+  for(i = 0; i < aadlen; i += AES_BLOCK_LEN) {
+    for(j = 0; j < AES_BLOCK_LEN && i + j < aadlen; j++) {
+      x[j] ^= aad[i + j];
+    }
+    aes_soft_block(x);
+  }
+  free(aad);
+  for(i = 0; i < plen; i += AES_BLOCK_LEN) {
+    for(j = 0; j < AES_BLOCK_LEN && i + j < plen; j++) {
+      x[j] ^= p[i + j];
+    }
+    aes_soft_block(x);
+  }
+
+  /* A_i: flags, nonce, i */
+  for(n = 0; n <= (plen + AES_BLOCK_LEN - 1) / AES_BLOCK_LEN; n++) {
+    memset(blk, 0, AES_BLOCK_LEN);
+    blk[0] = l - 1;
+    memcpy(&blk[1], nonce, 15 - l);
+    for(i = 0, j = n; i < l; i++, j >>= 8) {
+      blk[15 - i] = j;
+    }
+    memcpy(s, blk, AES_BLOCK_LEN);
+    aes_soft_block(s);
+
+    if(n == 0) {
+      for(i = 0; i < m; i++) {
+        c[plen + i] = x[i] ^ s[i];
+      }
+    } else {
+      for(i = 0; i < AES_BLOCK_LEN && (n - 1) * AES_BLOCK_LEN + i < plen; i++) {
+        c[(n - 1) * AES_BLOCK_LEN + i] = p[(n - 1) * AES_BLOCK_LEN + i] ^ s[i];
+      }
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+check_aes(void)
+{
+  static const uint8_t key[] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+  };
+  static const uint8_t want[] = {
+    0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+    0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a,
+  };
+  uint8_t blk[AES_BLOCK_LEN] = {
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+    0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff,
+  };
+
+  aes_set_key(key);
+  aes_soft_block(blk);
+  check("AES-128, FIPS-197 C.1", blk, want, AES_BLOCK_LEN);
+}
+/*---------------------------------------------------------------------------*/
+static void
+check_ref(void)
+{
+  static const uint8_t rfc_key[] = {
+    0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7,
+    0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf,
+  };
+  static const uint8_t rfc_nonce[] = {
+    0x00, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0xa0,
+    0xa1, 0xa2, 0xa3, 0xa4, 0xa5,
+  };
+  static const uint8_t rfc_in[] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+    0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e,
+  };
+  static const uint8_t rfc_out[] = {
+    0x58, 0x8c, 0x97, 0x9a, 0x61, 0xc6, 0x63, 0xd2,
+    0xf0, 0x66, 0xd0, 0xc2, 0xc0, 0xf9, 0x89, 0x80,
+    0x6d, 0x5f, 0x6b, 0x61, 0xda, 0xc3, 0x84, 0x17,
+    0xe8, 0xd1, 0x2c, 0xfd, 0xf9, 0x26, 0xe0,
+  };
+  static const uint8_t nist_key[] = {
+    0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47,
+    0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f,
+  };
+  static const uint8_t nist_nonce[] = {
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16,
+  };
+  static const uint8_t nist_a[] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+  };
+  static const uint8_t nist_p[] = {
+    0x20, 0x21, 0x22, 0x23,
+  };
+  static const uint8_t nist_out[] = {
+    0x71, 0x62, 0x01, 0x5b, 0x4d, 0xac, 0x25, 0x5d,
+  };
+  uint8_t out[64];
+
+  /* 8 bytes of additional data, 23 of text, M = 8 */
+  aes_set_key(rfc_key);
+  ref_ccm(8, 2, rfc_nonce, rfc_in, 8, rfc_in + 8, sizeof(rfc_in) - 8, out);
+  check("CCM, RFC 3610 packet vector #1", out, rfc_out, sizeof(rfc_out));
+
+  aes_set_key(nist_key);
+  ref_ccm(4, 8, nist_nonce, nist_a, sizeof(nist_a), nist_p, sizeof(nist_p),
+          out);
+  check("CCM, NIST SP 800-38C example 1", out, nist_out, sizeof(nist_out));
+}
+/*---------------------------------------------------------------------------*/
+static void
+check_link(void)
+{
+  static const uint8_t key[] = {
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+    0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+  };
+  uint8_t nonce[CCM_NONCE_LEN];
+  uint8_t p[255];
+  uint8_t want[255 + CCM_MIC_LEN];
+  uint8_t buf[255 + CCM_MIC_LEN];
+  int len;
+  int bad;
+  int i;
+
+  srand(1);
+  aes_set_key(key);
+
+  bad = 0;
+  for(len = 0; len <= 255; len++) {
+    for(i = 0; i < CCM_NONCE_LEN; i++) {
+      nonce[i] = rand();
+    }
+    for(i = 0; i < len; i++) {
+      p[i] = rand();
+    }
+
+    ref_ccm(CCM_MIC_LEN, 2, nonce, NULL, 0, p, len, want);
+    memcpy(buf, p, len);
+    ccm_seal(nonce, buf, len, buf + len);
+    if(memcmp(buf, want, len + CCM_MIC_LEN) != 0) {
+      if(!bad) {
+        check("ccm_seal() against the plain CCM", buf, want, len + CCM_MIC_LEN);
+      }
+      bad++;
+      continue;
+    }
+
+    if(!ccm_open(nonce, buf, len, buf + len) || memcmp(buf, p, len) != 0) {
+      bad++;
+      continue;
+    }
+
+    /* a flipped bit anywhere, text or MIC, must be caught */
+    i = rand() % (len + CCM_MIC_LEN);
+    memcpy(buf, want, len + CCM_MIC_LEN);
+    buf[i] ^= 1 << (rand() % 8);
+    if(ccm_open(nonce, buf, len, buf + len)) {
+      bad++;
+    }
+  }
+
+  if(bad) {
+    failed++;
+    printf("FAIL ccm.c, M = 4, L = 2: %d lengths of 256 wrong\n", bad);
+  } else {
+    printf("ok   ccm.c seal, open and forgeries, M = 4, L = 2, 0 to 255 bytes\n");
+  }
+}
+/*---------------------------------------------------------------------------*/
+int
+main(void)
+{
+  check_aes();
+  check_ref();
+  check_link();
+
+  return failed ? 1 : 0;
+}
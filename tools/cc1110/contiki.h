@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Stands in for contiki.h when the cc1110 sources that do not
+ *         touch the hardware are built on the host: they only need the
+ *         integer types, and the 8051 memory spaces mean nothing here.
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#ifndef CONTIKI_H_
+#define CONTIKI_H_
+
+#include <stdint.h>
+
+#define __xdata
+#define __code
+
+#endif /* CONTIKI_H_ */
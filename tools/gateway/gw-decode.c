@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Print the frames a gateway sends over the serial line, one per
+ *         line:
+ *
+ *           <src> <rssi> <lqi> <tick> <payload in hex, - if empty>
+ *
+ *         the same format gw-replay reads.
+ *
+ *         usage: gw-decode [-b baud] [tty or capture file, default stdin]
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#include "gw-frame.h"
+#include "gw-tty.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+static struct gw_parser parser;
+static struct gw_frame frame;
+/*---------------------------------------------------------------------------*/
+static void
+print_frame(const struct gw_frame *f)
+{
+  int i;
+
+  printf("%u.%u %d %u %u ", f->src[0], f->src[1], f->rssi, f->lqi, f->tick);
+  if(f->len == 0) {
+    printf("-");
+  }
+  for(i = 0; i < f->len; i++) {
+    printf("%02x", f->payload[i]);
+  }
+  printf("\n");
+  fflush(stdout);
+}
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char **argv)
+{
+  unsigned char buf[256];
+  const char *path = "-";
+  int baud = GW_TTY_BAUD;
+  ssize_t n, i;
+  int fd, opt;
+
+  while((opt = getopt(argc, argv, "b:")) != -1) {
+    if(opt == 'b') {
+      baud = atoi(optarg);
+    } else {
+      fprintf(stderr, "usage: %s [-b baud] [tty]\n", argv[0]);
+      return 1;
+    }
+  }
+  if(optind < argc) {
+    path = argv[optind];
+  }
+
+  fd = gw_tty_open(path, 0, baud);
+  if(fd < 0) {
+    perror(path);
+    return 1;
+  }
+
+  gw_parser_init(&parser);
+  while((n = read(fd, buf, sizeof(buf))) > 0) {
+    for(i = 0; i < n; i++) {
+      if(gw_parser_input(&parser, buf[i], &frame)) {
+        do {
+          print_frame(&frame);
+        } while(gw_parser_next(&parser, &frame));
+      }
+    }
+  }
+
+  return n < 0;
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Gateway emulator on a pseudo terminal, to load a host without
+ *         the hardware.
+ *
+ *         Prints the name of the pty slave, then writes the frames of
+ *         -n nodes at -r frames a second, in bursts every -w milliseconds
+ *         as the gateway does. A frame carries a 16 bit counter, so the
+ *         host can spot the lost ones:
+ *
+ *           gw-emu -r 5000 &
+ *           gw-daemon.native /dev/pts/N
+ *
+ *         usage: gw-emu [-n nodes] [-r frames/s] [-l payload] [-w ms]
+ *                       [-c count]
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#define _GNU_SOURCE
+#include "gw-frame.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+static unsigned char burst[1 << 16];
+/*---------------------------------------------------------------------------*/
+static long
+now_ms(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+/*---------------------------------------------------------------------------*/
+static int
+pty_open(void)
+{
+  struct termios tio;
+  int fd;
+
+  fd = posix_openpt(O_RDWR | O_NOCTTY);
+  if(fd < 0 || grantpt(fd) < 0 || unlockpt(fd) < 0) {
+    return -1;
+  }
+  if(tcgetattr(fd, &tio) == 0) {
+    cfmakeraw(&tio);
+    tcsetattr(fd, TCSANOW, &tio);
+  }
+  return fd;
+}
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char **argv)
+{
+  int nodes = 8, rate = 1000, len = 16, window = 62;
+  long count = -1, sent = 0, start, wait;
+  unsigned node;
+  uint8_t payload[GW_FRAME_MAX_PAYLOAD];
+  uint8_t src[2];
+  size_t n, done;
+  ssize_t w;
+  int fd, opt, per_burst, i;
+
+  while((opt = getopt(argc, argv, "n:r:l:w:c:")) != -1) {
+    switch(opt) {
+    case 'n':
+      nodes = atoi(optarg);
+      break;
+    case 'r':
+      rate = atoi(optarg);
+      break;
+    case 'l':
+      len = atoi(optarg);
+      break;
+    case 'w':
+      window = atoi(optarg);
+      break;
+    case 'c':
+      count = atol(optarg);
+      break;
+    default:
+      fprintf(stderr, "usage: %s [-n nodes] [-r frames/s] [-l payload] "
+              "[-w ms] [-c count]\n", argv[0]);
+      return 1;
+    }
+  }
+  if(nodes < 1 || nodes > 65534 || rate < 1 || window < 1 ||
+     len < 2 || len > GW_FRAME_MAX_PAYLOAD) {
+    fprintf(stderr, "gw-emu: bad arguments\n");
+    return 1;
+  }
+
+  per_burst = rate * window / 1000;
+  if(per_burst < 1) {
+    per_burst = 1;
+  }
+  if(per_burst > sizeof(burst) / (len + GW_FRAME_OVERHEAD)) {
+    per_burst = sizeof(burst) / (len + GW_FRAME_OVERHEAD);
+  }
+
+  fd = pty_open();
+  if(fd < 0) {
+    perror("gw-emu: pty");
+    return 1;
+  }
+  printf("%s\n", ptsname(fd));
+  fflush(stdout);
+
+  memset(payload, 0, sizeof(payload));
+  start = now_ms();
+  while(count < 0 || sent < count) {
+    for(i = 0, n = 0; i < per_burst && sent != count; i++, sent++) {
+      node = sent % nodes + 1;
+      src[0] = node >> 8;
+      src[1] = node & 0xFF;
+      payload[0] = (sent / nodes) & 0xFF;
+      payload[1] = (sent / nodes) >> 8;
+      n += gw_frame_encode(burst + n, src, -40 - sent % 50, sent % 64,
+                           now_ms() - start, payload, len);
+    }
+
+    /* blocks while nobody reads the slave: the gateway would overflow */
+    for(done = 0; done < n; done += w) {
+      w = write(fd, burst + done, n - done);
+      if(w < 0) {
+        perror("gw-emu");
+        return 1;
+      }
+    }
+
+    /* keep the average rate, whatever the write took */
+    wait = sent * 1000 / rate - (now_ms() - start);
+    if(wait > 0) {
+      usleep(wait * 1000);
+    }
+  }
+
+  /* let the reader drain the pty before the slave goes away */
+  tcdrain(fd);
+  sleep(1);
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Check of the gateway frame parser: frames with junk between
+ *         them, a lot of it 0xA5 and plausible lengths, must all come out,
+ *         in order and intact, also when a false sync takes the next
+ *         frames as its body.
+ *
+ *         usage: gw-frame-test (exit status 0 if every check passes)
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#include "gw-frame.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FRAMES 20000
+
+static uint8_t stream[FRAMES * (GW_FRAME_OVERHEAD + GW_FRAME_MAX_PAYLOAD + 64)];
+static int len;
+
+static struct gw_parser parser;
+static int got;
+static int bad;
+/*---------------------------------------------------------------------------*/
+/* The payload of frame n: its number, then bytes that follow from it */
+static uint8_t
+payload(int n, uint8_t *buf)
+{
+  uint8_t l;
+  int i;
+
+  l = 2 + n % (GW_FRAME_MAX_PAYLOAD - 1);
+  buf[0] = n & 0xFF;
+  buf[1] = n >> 8;
+  for(i = 2; i < l; i++) {
+    buf[i] = n * 7 + i;
+  }
+  return l;
+}
+/*---------------------------------------------------------------------------*/
+static void
+put_frame(int n)
+{
+  uint8_t buf[GW_FRAME_MAX_PAYLOAD];
+  uint8_t src[2] = { n, n >> 8 };
+  uint8_t l;
+
+  l = payload(n, buf);
+  len += gw_frame_encode(&stream[len], src, -n % 100, n, n, buf, l);
+}
+/*---------------------------------------------------------------------------*/
+/* Debug text, stray syncs, and syncs with a length that fits a frame */
+static void
+put_junk(void)
+{
+  int n;
+
+  switch(rand() % 4) {
+  case 0:
+    break;
+  case 1:
+    len += sprintf((char *)&stream[len], "debug %d\n", rand());
+    break;
+  case 2:
+    for(n = rand() % 8; n > 0; n--) {
+      stream[len++] = rand() % 2 ? GW_FRAME_SYNC : rand();
+    }
+    break;
+  default:
+    stream[len++] = GW_FRAME_SYNC;
+    stream[len++] = GW_FRAME_HDR_LEN + rand() % (GW_FRAME_MAX_PAYLOAD + 1);
+    for(n = rand() % 4; n > 0; n--) {
+      stream[len++] = rand();
+    }
+    break;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+frame_check(const struct gw_frame *f)
+{
+  uint8_t buf[GW_FRAME_MAX_PAYLOAD];
+  uint8_t l;
+
+  l = payload(got, buf);
+  if(f->src[0] != (got & 0xFF) || f->src[1] != (uint8_t)(got >> 8) ||
+     f->rssi != (int8_t)(-got % 100) || f->lqi != (uint8_t)got ||
+     f->tick != (uint16_t)got || f->len != l || memcmp(f->payload, buf, l)) {
+    if(bad++ == 0) {
+      printf("FAIL frame %d: src %02x%02x len %d\n", got, f->src[1],
+             f->src[0], f->len);
+    }
+  }
+  got++;
+}
+/*---------------------------------------------------------------------------*/
+static int
+run(const char *what, int junk)
+{
+  struct gw_frame frame;
+  int n;
+  int i;
+
+  srand(1);
+  len = 0;
+  for(n = 0; n < FRAMES; n++) {
+    if(junk) {
+      put_junk();
+    }
+    put_frame(n);
+  }
+  /* a false sync at the end holds the last frames until more bytes come */
+  memset(&stream[len], 0, GW_FRAME_OVERHEAD + GW_FRAME_MAX_PAYLOAD);
+  len += GW_FRAME_OVERHEAD + GW_FRAME_MAX_PAYLOAD;
+
+  gw_parser_init(&parser);
+  got = 0;
+  bad = 0;
+  for(i = 0; i < len; i++) {
+    if(gw_parser_input(&parser, stream[i], &frame)) {
+      do {
+        frame_check(&frame);
+      } while(gw_parser_next(&parser, &frame));
+    }
+  }
+
+  if(bad || got != FRAMES) {
+    printf("FAIL %s: %d of %d frames, %d wrong\n", what, got, FRAMES, bad);
+    return 1;
+  }
+  printf("ok   %s: %d frames, %u false syncs\n", what, got,
+         parser.errors);
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+int
+main(void)
+{
+  int failed = 0;
+
+  failed += run("frames back to back", 0);
+  failed += run("frames and junk", 1);
+
+  return failed ? 1 : 0;
+}
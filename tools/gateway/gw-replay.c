@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Play frames to a gateway host, as the gateway would send them.
+ *
+ *         Reads gw-decode lines (<src> <rssi> <lqi> <tick> <hex payload>)
+ *         and writes the binary frames. The lines up to an empty one go
+ *         out in one burst, then gw-replay waits -d milliseconds, so a
+ *         decode session can be replayed on the native platform:
+ *
+ *           gw-decode /dev/ttyUSB0 > session.txt
+ *           gw-replay -d 62 session.txt | gw-decode
+ *
+ *         usage: gw-replay [-d ms] [-o tty or file] [input, default stdin]
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#include "gw-frame.h"
+#include "gw-tty.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static unsigned char burst[4096];
+static size_t burst_len;
+/*---------------------------------------------------------------------------*/
+static int
+flush_burst(int fd, int delay_ms)
+{
+  size_t done = 0;
+  ssize_t n;
+
+  while(done < burst_len) {
+    n = write(fd, burst + done, burst_len - done);
+    if(n < 0) {
+      return -1;
+    }
+    done += n;
+  }
+  burst_len = 0;
+
+  if(delay_ms > 0) {
+    usleep(delay_ms * 1000);
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+/* One gw-decode line, 0 if it is malformed */
+static int
+parse_line(const char *line, uint8_t *src, int8_t *rssi, uint8_t *lqi,
+           uint16_t *tick, uint8_t *payload, uint8_t *len)
+{
+  unsigned s0, s1, q, t, byte;
+  char hex[2 * GW_FRAME_MAX_PAYLOAD + 3];
+  int r;
+  size_t i;
+
+  if(sscanf(line, "%u.%u %d %u %u %256s", &s0, &s1, &r, &q, &t, hex) != 6) {
+    return 0;
+  }
+  src[0] = s0;
+  src[1] = s1;
+  *rssi = r;
+  *lqi = q;
+  *tick = t;
+
+  *len = 0;
+  if(strcmp(hex, "-") == 0) {
+    return 1;
+  }
+  if(strlen(hex) % 2 != 0 || strlen(hex) / 2 > GW_FRAME_MAX_PAYLOAD) {
+    return 0;
+  }
+  for(i = 0; hex[i] != '\0'; i += 2) {
+    if(sscanf(&hex[i], "%2x", &byte) != 1) {
+      return 0;
+    }
+    payload[(*len)++] = byte;
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char **argv)
+{
+  char line[512];
+  uint8_t src[2], lqi, len;
+  uint8_t payload[GW_FRAME_MAX_PAYLOAD];
+  uint16_t tick;
+  int8_t rssi;
+  const char *out = "-";
+  int delay_ms = 0;
+  int fd, opt;
+  FILE *in = stdin;
+
+  while((opt = getopt(argc, argv, "d:o:")) != -1) {
+    if(opt == 'd') {
+      delay_ms = atoi(optarg);
+    } else if(opt == 'o') {
+      out = optarg;
+    } else {
+      fprintf(stderr, "usage: %s [-d ms] [-o tty] [input]\n", argv[0]);
+      return 1;
+    }
+  }
+  if(optind < argc && (in = fopen(argv[optind], "r")) == NULL) {
+    perror(argv[optind]);
+    return 1;
+  }
+
+  fd = gw_tty_open(out, 1, GW_TTY_BAUD);
+  if(fd < 0) {
+    perror(out);
+    return 1;
+  }
+
+  while(fgets(line, sizeof(line), in) != NULL) {
+    if(line[0] == '\n') {
+      if(flush_burst(fd, delay_ms) < 0) {
+        return 1;
+      }
+      continue;
+    }
+    if(!parse_line(line, src, &rssi, &lqi, &tick, payload, &len)) {
+      fprintf(stderr, "skipping: %s", line);
+      continue;
+    }
+    if(burst_len + len + GW_FRAME_OVERHEAD > sizeof(burst) &&
+       flush_burst(fd, 0) < 0) {
+      return 1;
+    }
+    burst_len += gw_frame_encode(burst + burst_len, src, rssi, lqi, tick,
+                                 payload, len);
+  }
+
+  return flush_burst(fd, 0) < 0;
+}
+/*---------------------------------------------------------------------------*/
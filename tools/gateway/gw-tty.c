@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Serial port set up for the gateway host tools
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#include "gw-tty.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+/*---------------------------------------------------------------------------*/
+static speed_t
+tty_speed(int baud)
+{
+  switch(baud) {
+  case 9600:
+    return B9600;
+  case 38400:
+    return B38400;
+  case 57600:
+    return B57600;
+  case 115200:
+    return B115200;
+  default:
+    return B230400;
+  }
+}
+/*---------------------------------------------------------------------------*/
+int
+gw_tty_open(const char *path, int write, int baud)
+{
+  struct termios tio;
+  int fd;
+
+  if(strcmp(path, "-") == 0) {
+    return write ? STDOUT_FILENO : STDIN_FILENO;
+  }
+
+  fd = open(path, (write ? O_WRONLY | O_CREAT | O_TRUNC : O_RDONLY) | O_NOCTTY,
+            0644);
+  if(fd < 0 || !isatty(fd)) {
+    return fd;
+  }
+
+  if(tcgetattr(fd, &tio) < 0) {
+    close(fd);
+    return -1;
+  }
+  cfmakeraw(&tio);
+  tio.c_cflag |= CLOCAL | CREAD | CRTSCTS;
+  tio.c_cc[VMIN] = 1;
+  tio.c_cc[VTIME] = 0;
+  cfsetispeed(&tio, tty_speed(baud));
+  cfsetospeed(&tio, tty_speed(baud));
+  if(tcsetattr(fd, TCSANOW, &tio) < 0) {
+    close(fd);
+    return -1;
+  }
+
+  return fd;
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Serial port set up for the gateway host tools
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#ifndef GW_TTY_H_
+#define GW_TTY_H_
+
+/* Gateway default: 230400 8N1, RTS/CTS */
+#define GW_TTY_BAUD 230400
+
+/*
+ * Open path for reading or writing. A tty is put in raw mode at 'baud',
+ * anything else (a pipe, a capture file) is used as it is. "-" is
+ * stdin/stdout. Returns the fd, -1 on error.
+ */
+int gw_tty_open(const char *path, int write, int baud);
+
+#endif /* GW_TTY_H_ */
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Check of the medium broker: a node that leaves while a frame is on
+ *         air for it, and a new node that takes its slot before the frame
+ *         ends, must not get that frame nor its carrier off. The slot is
+ *         used once before, its gen must go on counting.
+ *
+ *         usage: medium-test ./medium (exit status 0 if the checks pass)
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#define _GNU_SOURCE
+#include "vradio.h"
+
+#include <poll.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/* 20 bytes at 1000 bit/s: more than 200 ms on air */
+#define BITRATE   "1000"
+#define FRAME_LEN 20
+#define SETTLE_MS 50
+#define AIR_MS    400
+
+static char path[64];
+static pid_t medium;
+static int failed;
+/*---------------------------------------------------------------------------*/
+static void
+check(const char *what, int ok)
+{
+  printf("%s %s\n", ok ? "ok  " : "FAIL", what);
+  if(!ok) {
+    failed++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* A node with address a.0, after the medium took its hello */
+static int
+node_open(uint8_t a)
+{
+  struct sockaddr_un addr;
+  uint8_t hello[3] = { VRADIO_HELLO, a, 0 };
+  int fd;
+
+  fd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+  if(fd < 0 || connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+     send(fd, hello, sizeof(hello), 0) < 0) {
+    perror(path);
+    exit(1);
+  }
+  usleep(SETTLE_MS * 1000);
+  return fd;
+}
+/*---------------------------------------------------------------------------*/
+/* The medium sees the node gone before the next one comes */
+static void
+node_close(int fd)
+{
+  close(fd);
+  usleep(SETTLE_MS * 1000);
+}
+/*---------------------------------------------------------------------------*/
+static void
+node_tx(int fd)
+{
+  uint8_t msg[1 + FRAME_LEN];
+
+  msg[0] = VRADIO_TX;
+  memset(msg + 1, 0x5A, FRAME_LEN);
+  send(fd, msg, sizeof(msg), 0);
+}
+/*---------------------------------------------------------------------------*/
+/* The type of the next message within ms, 0 if none */
+static uint8_t
+node_next(int fd, int ms)
+{
+  struct pollfd p = { fd, POLLIN, 0 };
+  uint8_t msg[VRADIO_RX_HDR + VRADIO_MAX_FRAME];
+
+  if(poll(&p, 1, ms) <= 0 || recv(fd, msg, sizeof(msg), 0) <= 0) {
+    return 0;
+  }
+  if(msg[0] == VRADIO_RX && msg[VRADIO_RX_HDR] != 0x5A) {
+    return '?';
+  }
+  return msg[0];
+}
+/*---------------------------------------------------------------------------*/
+static void
+medium_stop(void)
+{
+  kill(medium, SIGTERM);
+  waitpid(medium, NULL, 0);
+  unlink(path);
+}
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char **argv)
+{
+  int a, b;
+
+  if(argc < 2) {
+    fprintf(stderr, "usage: %s ./medium\n", argv[0]);
+    return 1;
+  }
+
+  snprintf(path, sizeof(path), "/tmp/medium-test.%d", (int)getpid());
+  medium = fork();
+  if(medium == 0) {
+    freopen("/dev/null", "w", stdout);
+    execl(argv[1], argv[1], "-s", path, "-b", BITRATE, "-j", "0", NULL);
+    perror(argv[1]);
+    _exit(1);
+  }
+  usleep(4 * SETTLE_MS * 1000);
+
+  a = node_open(1);
+
+  /* use the slot of the second node once */
+  b = node_open(2);
+  node_close(b);
+  b = node_open(2);
+
+  /* it leaves with a frame on air for it, a new node takes the slot */
+  node_tx(a);
+  check("carrier on at the receiver", node_next(b, AIR_MS) == VRADIO_BUSY);
+  node_close(b);
+  b = node_open(2);
+  check("the new node in the slot misses the frame of the old one",
+        node_next(b, AIR_MS) == 0);
+
+  /* and gets the next frame as any other */
+  node_tx(a);
+  check("next frame: carrier on", node_next(b, AIR_MS) == VRADIO_BUSY);
+  check("next frame: received", node_next(b, AIR_MS) == VRADIO_RX);
+  check("next frame: carrier off", node_next(b, AIR_MS) == VRADIO_IDLE);
+
+  close(a);
+  close(b);
+  medium_stop();
+
+  return failed ? 1 : 0;
+}
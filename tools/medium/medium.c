@@ -0,0 +1,541 @@
+/*
+ * Copyright (c) 2013, Piccino Lab (piccino.lab@gmail.com)
+ * All rights reserved.
+ *
+ */
+
+/**
+ * \file
+ *         Radio medium broker for the native nodes (platform/native/dev/vradio.h)
+ *
+ *         A frame reaches the neighbors of its sender once its airtime is
+ *         over. The neighbors get VRADIO_BUSY when it starts and
+ *         VRADIO_IDLE when nothing is left on air for them. A frame is lost
+ *         at a receiver when:
+ *
+ *         - the receiver is transmitting (half duplex);
+ *         - another frame overlaps and is not at least -c dB weaker
+ *           (capture), a stronger late frame wins over the first one;
+ *         - the random link loss says so.
+ *
+ *         Without -t every node hears every other one at -r dBm, +- -j dB
+ *         of random fading per frame. A topology file lists the links
+ *         instead, one per line, directed:
+ *
+ *           # sender receiver rssi [loss %]
+ *           1.0 2.0 -70
+ *           2.0 1.0 -72 10
+ *
+ *         usage: medium [-s socket] [-b bit/s] [-l loss %] [-r rssi]
+ *                       [-j fading dB] [-c capture dB] [-t topology]
+ *                       [-S seed]
+ *
+ *         Statistics go to stdout every 10 s and on SIGINT/SIGTERM.
+ * \author
+ *         Attilio Dona' - <piccino.lab@gmail.com>
+ */
+#define _GNU_SOURCE
+#include "vradio.h"
+
+#include <errno.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#define NODES_MAX      4096
+#define EVENTS_MAX     64
+#define STATS_INTERVAL 10000000   /* us */
+
+/* preamble, sync word, length and crc of the CC1101 packet engine */
+#define PHY_OVERHEAD   (4 + 4 + 1 + 2)
+
+/* LQI reported with a good frame: the CC1101 correlation, lower is better */
+#define LQI_GOOD       10
+
+struct link {
+  uint16_t src, dst;
+  int8_t rssi;
+  uint8_t loss;
+};
+
+struct nbr {
+  int node;
+  int8_t rssi;
+  uint8_t loss;
+};
+
+struct node {
+  int fd;                /* -1: free slot */
+  unsigned gen;          /* bumped on every reuse of the slot */
+  uint16_t addr;         /* 0xFFFF until the hello */
+  struct nbr *nbrs;
+  int nnbrs;
+  int busy;              /* frames on air that reach this node */
+  struct air *current;   /* the frame the receiver is locked on */
+  uint64_t tx_end;
+};
+
+struct air_rx {
+  int node;
+  unsigned gen;
+  int8_t rssi;
+  uint8_t ok;
+  uint8_t loss;
+};
+
+struct air {
+  struct air *next;
+  uint64_t end;
+  int sender;
+  uint8_t len;
+  uint8_t frame[VRADIO_MAX_FRAME];
+  int nrx;
+  struct air_rx rx[];
+};
+
+static struct node nodes[NODES_MAX];
+static int nnodes;
+static struct air *on_air;  /* sorted by end */
+
+static struct link *links;
+static int nlinks;
+static int topology;
+
+static long bitrate = 38400;
+static int loss_pct = 0;
+static int rssi_dbm = -60;
+static int fading_db = 3;
+static int capture_db = 6;
+
+static unsigned long st_tx, st_rx, st_collided, st_lost, st_halfduplex,
+  st_dropped;
+static volatile sig_atomic_t stop;
+/*---------------------------------------------------------------------------*/
+static uint64_t
+now_us(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+/*---------------------------------------------------------------------------*/
+static void
+stats_print(void)
+{
+  printf("nodes %d tx %lu rx %lu collided %lu half duplex %lu lost %lu "
+         "dropped %lu\n", nnodes, st_tx, st_rx, st_collided, st_halfduplex,
+         st_lost, st_dropped);
+  fflush(stdout);
+}
+/*---------------------------------------------------------------------------*/
+static void
+node_send(int i, const uint8_t *msg, size_t len)
+{
+  if(send(nodes[i].fd, msg, len, MSG_DONTWAIT | MSG_NOSIGNAL) < 0) {
+    /* the node does not keep up, same as a missed frame */
+    st_dropped++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+node_signal(int i, uint8_t type)
+{
+  node_send(i, &type, 1);
+}
+/*---------------------------------------------------------------------------*/
+static int
+parse_addr(const char *s, uint16_t *addr)
+{
+  unsigned a, b;
+
+  if(sscanf(s, "%u.%u", &a, &b) != 2 || a > 255 || b > 255) {
+    return 0;
+  }
+  *addr = a | (b << 8);
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+topology_load(const char *path)
+{
+  char line[128], src[16], dst[16];
+  int rssi, loss, n, lineno = 0;
+  FILE *f;
+
+  f = fopen(path, "r");
+  if(f == NULL) {
+    perror(path);
+    return 0;
+  }
+
+  while(fgets(line, sizeof(line), f) != NULL) {
+    lineno++;
+    loss = loss_pct;
+    n = sscanf(line, "%15s %15s %d %d", src, dst, &rssi, &loss);
+    if(n <= 0 || src[0] == '#') {
+      continue;
+    }
+    links = realloc(links, (nlinks + 1) * sizeof(struct link));
+    if(n < 3 || !parse_addr(src, &links[nlinks].src) ||
+       !parse_addr(dst, &links[nlinks].dst)) {
+      fprintf(stderr, "%s:%d: bad link\n", path, lineno);
+      fclose(f);
+      return 0;
+    }
+    links[nlinks].rssi = rssi;
+    links[nlinks].loss = loss;
+    nlinks++;
+  }
+
+  fclose(f);
+  topology = 1;
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+link_get(int src, int dst, struct nbr *n)
+{
+  int i;
+
+  n->node = dst;
+  if(!topology) {
+    n->rssi = rssi_dbm;
+    n->loss = loss_pct;
+    return 1;
+  }
+
+  for(i = 0; i < nlinks; i++) {
+    if(links[i].src == nodes[src].addr && links[i].dst == nodes[dst].addr) {
+      n->rssi = links[i].rssi;
+      n->loss = links[i].loss;
+      return 1;
+    }
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static void
+nbr_add(int src, const struct nbr *n)
+{
+  nodes[src].nbrs = realloc(nodes[src].nbrs,
+                            (nodes[src].nnbrs + 1) * sizeof(struct nbr));
+  nodes[src].nbrs[nodes[src].nnbrs++] = *n;
+}
+/*---------------------------------------------------------------------------*/
+/* The links between a node that said hello and the ones already there */
+static void
+node_join(int i)
+{
+  struct nbr n;
+  int j;
+
+  for(j = 0; j < NODES_MAX; j++) {
+    if(j == i || nodes[j].fd < 0 || nodes[j].addr == 0xFFFF) {
+      continue;
+    }
+    if(link_get(i, j, &n)) {
+      nbr_add(i, &n);
+    }
+    if(link_get(j, i, &n)) {
+      nbr_add(j, &n);
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+node_leave(int i)
+{
+  unsigned gen;
+  int j, k;
+
+  for(j = 0; j < NODES_MAX; j++) {
+    for(k = 0; k < nodes[j].nnbrs; k++) {
+      if(nodes[j].nbrs[k].node == i) {
+        nodes[j].nbrs[k] = nodes[j].nbrs[--nodes[j].nnbrs];
+        break;
+      }
+    }
+  }
+
+  /* the frames on air still list the slot, the new gen tells them apart */
+  gen = nodes[i].gen;
+  close(nodes[i].fd);
+  free(nodes[i].nbrs);
+  memset(&nodes[i], 0, sizeof(struct node));
+  nodes[i].fd = -1;
+  nodes[i].gen = gen + 1;
+  nnodes--;
+}
+/*---------------------------------------------------------------------------*/
+static void
+air_start(int sender, const uint8_t *frame, uint8_t len, uint64_t now)
+{
+  struct node *s = &nodes[sender];
+  struct node *r;
+  struct air *a, **p;
+  struct air_rx *rx;
+  struct air *c;
+  int i, k, fade;
+
+  a = malloc(sizeof(struct air) + s->nnbrs * sizeof(struct air_rx));
+  if(a == NULL) {
+    return;
+  }
+  a->sender = sender;
+  a->len = len;
+  memcpy(a->frame, frame, len);
+  a->end = now + (uint64_t)(len + PHY_OVERHEAD) * 8 * 1000000 / bitrate;
+  a->nrx = s->nnbrs;
+  st_tx++;
+
+  /* half duplex: the frame the sender was receiving is gone */
+  if(s->current != NULL) {
+    for(k = 0; k < s->current->nrx; k++) {
+      if(s->current->rx[k].node == sender) {
+        s->current->rx[k].ok = 0;
+        st_halfduplex++;
+      }
+    }
+    s->current = NULL;
+  }
+  s->tx_end = a->end;
+
+  for(i = 0; i < s->nnbrs; i++) {
+    rx = &a->rx[i];
+    r = &nodes[s->nbrs[i].node];
+    fade = fading_db ? rand() % (2 * fading_db + 1) - fading_db : 0;
+    rx->node = s->nbrs[i].node;
+    rx->gen = r->gen;
+    rx->rssi = s->nbrs[i].rssi + fade;
+    rx->loss = s->nbrs[i].loss;
+    rx->ok = 1;
+
+    if(r->tx_end > now) {
+      rx->ok = 0;
+      st_halfduplex++;
+    } else if(r->current == NULL) {
+      r->current = a;
+    } else {
+      /* collision, unless one of the two is much stronger */
+      c = r->current;
+      for(k = 0; c->rx[k].node != rx->node; k++);
+      if(rx->rssi >= c->rx[k].rssi + capture_db) {
+        c->rx[k].ok = 0;
+        r->current = a;
+      } else if(c->rx[k].rssi >= rx->rssi + capture_db) {
+        rx->ok = 0;
+      } else {
+        c->rx[k].ok = 0;
+        rx->ok = 0;
+      }
+      st_collided++;
+    }
+
+    if(r->busy++ == 0) {
+      node_signal(rx->node, VRADIO_BUSY);
+    }
+  }
+
+  for(p = &on_air; *p != NULL && (*p)->end <= a->end; p = &(*p)->next);
+  a->next = *p;
+  *p = a;
+}
+/*---------------------------------------------------------------------------*/
+static void
+air_end(struct air *a)
+{
+  uint8_t msg[VRADIO_RX_HDR + VRADIO_MAX_FRAME];
+  struct air_rx *rx;
+  struct node *r;
+  int i;
+
+  msg[0] = VRADIO_RX;
+  memcpy(msg + VRADIO_RX_HDR, a->frame, a->len);
+
+  for(i = 0; i < a->nrx; i++) {
+    rx = &a->rx[i];
+    r = &nodes[rx->node];
+    if(r->fd < 0 || r->gen != rx->gen) {
+      continue;
+    }
+    if(r->current == a) {
+      r->current = NULL;
+    }
+    if(rx->ok && rx->loss && rand() % 100 < rx->loss) {
+      st_lost++;
+    } else if(rx->ok) {
+      msg[1] = (uint8_t)rx->rssi;
+      msg[2] = LQI_GOOD;
+      node_send(rx->node, msg, VRADIO_RX_HDR + a->len);
+      st_rx++;
+    }
+    if(--r->busy == 0) {
+      node_signal(rx->node, VRADIO_IDLE);
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+node_input(int i)
+{
+  uint8_t msg[1 + VRADIO_MAX_FRAME];
+  ssize_t n;
+
+  while((n = recv(nodes[i].fd, msg, sizeof(msg), MSG_DONTWAIT)) > 0) {
+    if(msg[0] == VRADIO_HELLO && n == 3 && nodes[i].addr == 0xFFFF) {
+      nodes[i].addr = msg[1] | (msg[2] << 8);
+      node_join(i);
+    } else if(msg[0] == VRADIO_TX && n > 1 && nodes[i].addr != 0xFFFF) {
+      air_start(i, msg + 1, n - 1, now_us());
+    }
+  }
+
+  if(n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+    node_leave(i);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+on_signal(int sig)
+{
+  stop = 1;
+}
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char **argv)
+{
+  const char *path = VRADIO_SOCKET;
+  struct epoll_event ev, events[EVENTS_MAX];
+  struct sockaddr_un addr;
+  uint64_t now, stats_time;
+  struct air *a;
+  int lfd, efd, fd, opt, n, i, timeout;
+
+  srand(1);
+  while((opt = getopt(argc, argv, "s:b:l:r:j:c:t:S:")) != -1) {
+    switch(opt) {
+    case 's':
+      path = optarg;
+      break;
+    case 'b':
+      bitrate = atol(optarg);
+      break;
+    case 'l':
+      loss_pct = atoi(optarg);
+      break;
+    case 'r':
+      rssi_dbm = atoi(optarg);
+      break;
+    case 'j':
+      fading_db = atoi(optarg);
+      break;
+    case 'c':
+      capture_db = atoi(optarg);
+      break;
+    case 't':
+      if(!topology_load(optarg)) {
+        return 1;
+      }
+      break;
+    case 'S':
+      srand(atoi(optarg));
+      break;
+    default:
+      fprintf(stderr, "usage: %s [-s socket] [-b bit/s] [-l loss %%] "
+              "[-r rssi] [-j fading dB] [-c capture dB] [-t topology] "
+              "[-S seed]\n", argv[0]);
+      return 1;
+    }
+  }
+  if(bitrate <= 0 || fading_db < 0) {
+    fprintf(stderr, "medium: bad arguments\n");
+    return 1;
+  }
+
+  for(i = 0; i < NODES_MAX; i++) {
+    nodes[i].fd = -1;
+  }
+
+  lfd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+  unlink(path);
+  if(lfd < 0 || bind(lfd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+     listen(lfd, 128) < 0) {
+    perror(path);
+    return 1;
+  }
+
+  efd = epoll_create1(0);
+  ev.events = EPOLLIN;
+  ev.data.u32 = NODES_MAX;
+  epoll_ctl(efd, EPOLL_CTL_ADD, lfd, &ev);
+
+  signal(SIGINT, on_signal);
+  signal(SIGTERM, on_signal);
+  signal(SIGPIPE, SIG_IGN);
+
+  printf("medium on %s, %ld bit/s\n", path, bitrate);
+  fflush(stdout);
+
+  stats_time = now_us() + STATS_INTERVAL;
+  while(!stop) {
+    now = now_us();
+    timeout = now < stats_time ? (stats_time - now) / 1000 : 0;
+    if(on_air != NULL) {
+      timeout = on_air->end > now ? (on_air->end - now + 999) / 1000 : 0;
+    }
+
+    n = epoll_wait(efd, events, EVENTS_MAX, timeout);
+    for(i = 0; i < n; i++) {
+      if(events[i].data.u32 == NODES_MAX) {
+        fd = accept(lfd, NULL, NULL);
+        if(fd < 0) {
+          continue;
+        }
+        for(opt = 0; opt < NODES_MAX && nodes[opt].fd >= 0; opt++);
+        if(opt == NODES_MAX) {
+          close(fd);
+          continue;
+        }
+        nodes[opt].fd = fd;
+        nodes[opt].addr = 0xFFFF;
+        nnodes++;
+        ev.events = EPOLLIN;
+        ev.data.u32 = opt;
+        epoll_ctl(efd, EPOLL_CTL_ADD, fd, &ev);
+      } else if(nodes[events[i].data.u32].fd >= 0) {
+        node_input(events[i].data.u32);
+      }
+    }
+
+    now = now_us();
+    while(on_air != NULL && on_air->end <= now) {
+      a = on_air;
+      on_air = a->next;
+      air_end(a);
+      free(a);
+    }
+
+    if(now >= stats_time) {
+      if(st_tx) {
+        stats_print();
+      }
+      stats_time = now + STATS_INTERVAL;
+    }
+  }
+
+  stats_print();
+  unlink(path);
+  return 0;
+}
+/*---------------------------------------------------------------------------*/